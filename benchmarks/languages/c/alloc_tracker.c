@@ -0,0 +1,97 @@
+#define ALLOC_TRACKER_NO_MACROS
+#include "alloc_tracker.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// Size prefix, padded to keep the returned pointer maximally aligned
+#define TRACKER_HEADER 16
+
+static size_t live_bytes = 0;
+static size_t window_base = 0;
+static size_t window_peak = 0;
+static size_t window_allocations = 0;
+static size_t window_allocated = 0;
+static long window_maxrss_kb = 0;
+
+static void on_alloc(size_t size) {
+    live_bytes += size;
+    window_allocations++;
+    window_allocated += size;
+    if (live_bytes > window_peak) window_peak = live_bytes;
+}
+
+void* tracked_malloc(size_t size) {
+    unsigned char* block = (unsigned char*)malloc(size + TRACKER_HEADER);
+    if (!block) return NULL;
+    memcpy(block, &size, sizeof(size));
+    on_alloc(size);
+    return block + TRACKER_HEADER;
+}
+
+void* tracked_calloc(size_t count, size_t size) {
+    if (size != 0 && count > ((size_t)-1 - TRACKER_HEADER) / size) return NULL;
+    void* ptr = tracked_malloc(count * size);
+    if (ptr) memset(ptr, 0, count * size);
+    return ptr;
+}
+
+void tracked_free(void* ptr) {
+    if (!ptr) return;
+    unsigned char* block = (unsigned char*)ptr - TRACKER_HEADER;
+    size_t size;
+    memcpy(&size, block, sizeof(size));
+    live_bytes -= size;
+    free(block);
+}
+
+void* tracked_realloc(void* ptr, size_t size) {
+    if (!ptr) return tracked_malloc(size);
+    unsigned char* block = (unsigned char*)ptr - TRACKER_HEADER;
+    size_t old_size;
+    memcpy(&old_size, block, sizeof(old_size));
+    unsigned char* grown = (unsigned char*)realloc(block, size + TRACKER_HEADER);
+    if (!grown) return NULL;
+    memcpy(grown, &size, sizeof(size));
+    live_bytes -= old_size;
+    on_alloc(size);
+    return grown + TRACKER_HEADER;
+}
+
+// Helper: process peak RSS in KB (0 where getrusage is unavailable)
+static long peak_rss_kb(void) {
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) return usage.ru_maxrss;
+#endif
+    return 0;
+}
+
+void alloc_tracker_begin(void) {
+#ifdef __linux__
+    // "5" resets the peak RSS (Linux >= 4.0); otherwise the delta is measured
+    // against the previous high-water mark and may read 0
+    FILE* f = fopen("/proc/self/clear_refs", "w");
+    if (f) {
+        fputs("5", f);
+        fclose(f);
+    }
+#endif
+    window_base = live_bytes;
+    window_peak = live_bytes;
+    window_allocations = 0;
+    window_allocated = 0;
+    window_maxrss_kb = peak_rss_kb();
+}
+
+MemoryUsage alloc_tracker_end(void) {
+    MemoryUsage usage;
+    usage.peak_bytes = window_peak - window_base;
+    usage.allocations = window_allocations;
+    usage.allocated_bytes = window_allocated;
+    usage.maxrss_delta_kb = peak_rss_kb() - window_maxrss_kb;
+    return usage;
+}
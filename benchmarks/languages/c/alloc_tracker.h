@@ -0,0 +1,43 @@
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+/**
+ * Allocation tracking for the C benchmarks.
+ *
+ * Include this header BEFORE the algorithm headers: the implementations are
+ * header-only, so the macros below route their malloc/calloc/realloc/free
+ * calls through counting wrappers. Every block carries a small size prefix,
+ * which lets free() subtract the bytes it releases and keep an exact peak.
+ *
+ * Allocations made inside libc (e.g. qsort's temporary buffer) are not seen
+ * by the macros; the getrusage maxrss delta covers those.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+
+typedef struct {
+    size_t peak_bytes;      // Peak live bytes above the level at alloc_tracker_begin()
+    size_t allocations;     // malloc/calloc/realloc calls
+    size_t allocated_bytes; // Sum of requested bytes
+    long maxrss_delta_kb;   // Growth of the process peak RSS (getrusage), in KB
+} MemoryUsage;
+
+void* tracked_malloc(size_t size);
+void* tracked_calloc(size_t count, size_t size);
+void* tracked_realloc(void* ptr, size_t size);
+void tracked_free(void* ptr);
+
+// Start a measurement window (resets peak and counters, and the kernel's
+// peak RSS where /proc/self/clear_refs allows it)
+void alloc_tracker_begin(void);
+MemoryUsage alloc_tracker_end(void);
+
+#ifndef ALLOC_TRACKER_NO_MACROS
+#define malloc(size) tracked_malloc(size)
+#define calloc(count, size) tracked_calloc(count, size)
+#define realloc(ptr, size) tracked_realloc(ptr, size)
+#define free(ptr) tracked_free(ptr)
+#endif
+
+#endif // ALLOC_TRACKER_H
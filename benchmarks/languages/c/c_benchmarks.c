@@ -4,9 +4,13 @@
  * This benchmark suite mirrors the JavaScript benchmarks to ensure
  * fair cross-language comparisons. It includes:
  * - Same data generators (Random, Sorted, Reverse, K-sorted, etc.)
+ * - Production-like inputs (interleaved streams, sawtooth, organ pipe, Zipf,
+ *   sorted + random tail, periodic resets), identical to cpp_benchmarks per seed
+ * - --export-datasets writes every generated input as <stem>_<size>.dat
  * - Statistical analysis (mean, median, std deviation)
  * - JSON export for visualization
  * - Multiple repetitions for accuracy
+ * - Peak auxiliary heap bytes, allocation counts and maxrss growth per sort
  * 
  * Author: Mario Raúl Carbonell Martínez
  * Date: November 2025
@@ -19,6 +23,10 @@
 #include <stdbool.h>
 #include <math.h>
 
+// Allocation tracking: must precede the algorithm headers so their
+// malloc/free calls go through the counting wrappers
+#include "alloc_tracker.h"
+
 // Include algorithm implementations
 #include "../../../implementations/c/balanced_segment_merge_sort.h"
 #include "../../../implementations/c/block_merge_segment_sort.h"
@@ -41,6 +49,7 @@ typedef struct {
     int repetitions;
     double times[MAX_REPETITIONS];
     Statistics stats;
+    MemoryUsage memory; // One extra, untimed run
     bool success;
     char error[256];
 } BenchmarkResult;
@@ -107,6 +116,13 @@ BenchmarkResult run_benchmark(
     }
     
     result.stats = calculate_stats(result.times, repetitions);
+
+    // Memory: one more run outside the timed loop (arr is already allocated)
+    memcpy(arr, original_data, n * sizeof(int));
+    alloc_tracker_begin();
+    sort_func(arr, n);
+    result.memory = alloc_tracker_end();
+
     free(arr);
     return result;
 }
@@ -122,8 +138,7 @@ void export_results_to_json(BenchmarkResult* results, int result_count, const ch
     fprintf(f, "{\n");
     fprintf(f, "  \"metadata\": {\n");
     fprintf(f, "    \"timestamp\": \"%ld\",\n", (long)time(NULL));
-    // Seed is now private to generators, but we can't easily access it here without a getter. 
-    // For now hardcode or ignore printing seed, or add a getter in generators.h
+    fprintf(f, "    \"seed\": %lu,\n", get_seed());
     fprintf(f, "    \"platform\": \"C\",\n");
     fprintf(f, "    \"methodology\": \"Modular C Benchmark v2.0\"\n");
     fprintf(f, "  },\n");
@@ -148,6 +163,12 @@ void export_results_to_json(BenchmarkResult* results, int result_count, const ch
             fprintf(f, "        \"p5\": %.3f,\n", r->stats.p5);
             fprintf(f, "        \"p95\": %.3f\n", r->stats.p95);
             fprintf(f, "      },\n");
+            fprintf(f, "      \"memory\": {\n");
+            fprintf(f, "        \"peakAuxBytes\": %zu,\n", r->memory.peak_bytes);
+            fprintf(f, "        \"allocations\": %zu,\n", r->memory.allocations);
+            fprintf(f, "        \"allocatedBytes\": %zu,\n", r->memory.allocated_bytes);
+            fprintf(f, "        \"maxRssDeltaKB\": %ld\n", r->memory.maxrss_delta_kb);
+            fprintf(f, "      },\n");
             fprintf(f, "      \"allTimes\": [");
             for (int t = 0; t < r->repetitions; t++) {
                 fprintf(f, "%.3f%s", r->times[t], (t < r->repetitions - 1) ? ", " : "");
@@ -329,6 +350,9 @@ int main(int argc, char* argv[]) {
     int num_sizes = 0;
     int repetitions = 10;
     bool validate = true;
+    const char* datasets_dir = "../../datasets";
+    const char* export_dir = NULL;
+    unsigned long seed = 12345;
     
     if (argc > 1) {
         for (int i = 1; i < argc; i++) {
@@ -338,13 +362,28 @@ int main(int argc, char* argv[]) {
                 }
             } else if (strcmp(argv[i], "--no-validate") == 0) {
                 validate = false;
+            } else if (strcmp(argv[i], "--datasets") == 0) {
+                if (i + 1 < argc) {
+                    datasets_dir = argv[++i];
+                }
+            } else if (strcmp(argv[i], "--seed") == 0) {
+                if (i + 1 < argc) {
+                    seed = strtoul(argv[++i], NULL, 10);
+                }
+            } else if (strcmp(argv[i], "--export-datasets") == 0) {
+                if (i + 1 < argc) {
+                    export_dir = argv[++i];
+                }
             } else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
-                printf("Uso: c_benchmarks [sizes...] [--reps repetitions] [--no-validate]\n");
+                printf("Uso: c_benchmarks [sizes...] [--reps repetitions] [--no-validate] [--datasets dir]\n");
+                printf("                  [--seed S] [--export-datasets dir]\n");
                 printf("\nEjemplos:\n");
                 printf("  c_benchmarks                # Ejecuta con tamaño por defecto 100000\n");
                 printf("  c_benchmarks 50000          # Ejecuta solo para tamaño 50000\n");
                 printf("  c_benchmarks 10000 50000    # Ejecuta para varios tamaños\n");
                 printf("  c_benchmarks 100000 --reps 30  # 30 repeticiones\n");
+                printf("  c_benchmarks 100000 --export-datasets ../../../datasets  # Escribe <tipo>_100000.dat y sale\n");
+                printf("\nCon el mismo --seed los datos coinciden con cpp_benchmarks (mismo LCG y generadores).\n");
                 return 0;
             } else {
                 sizes[num_sizes++] = atoi(argv[i]);
@@ -356,6 +395,8 @@ int main(int argc, char* argv[]) {
         sizes[0] = 100000;
         num_sizes = 1;
     }
+
+    set_seed(seed);
     
     printf("[*] Configuracion:\n");
     printf("   - Tamanos: [");
@@ -364,6 +405,7 @@ int main(int argc, char* argv[]) {
     }
     printf("]\n");
     printf("   - Repeticiones: %d\n", repetitions);
+    printf("   - Seed: %lu\n", seed);
     printf("   - Validacion: %s\n", validate ? "Habilitada" : "Deshabilitada");
     printf("   - Version: Modular Clean Benchmark v2.0\n\n");
     
@@ -394,24 +436,31 @@ int main(int argc, char* argv[]) {
             return 1;
         }
         
-        // Test cases
+        // Test cases; stem is the dataset file name (<stem>_<size>.dat), same
+        // names as generate_datasets.py and cpp_benchmarks
         typedef struct {
             const char* name;
             const char* short_name;
-            void (*generator)(int*, size_t, int, int);
+            const char* stem;
             size_t param1;
-            size_t param2;
         } TestCase;
         
         TestCase test_cases[] = {
-            {"Aleatorio", "Aleatorio", (void*)generate_random_array, 0, 1000},
-            {"Ordenado", "Ordenado", (void*)generate_sorted_array, 0, 1000},
-            {"Inverso", "Inverso", (void*)generate_reverse_array, 0, 1000},
-            {"K-sorted (k=10%)", "K-sorted", NULL, n/10, 0},
-            {"Nearly Sorted (5% swaps)", "NearlySorted", NULL, n/20, 0},
-            {"Con Duplicados (20 únicos)", "Duplicados", NULL, 20, 0},
-            {"Plateau (10 segmentos)", "Plateau", NULL, n/10, 0},
-            {"Segment Sorted (5 segmentos)", "SegmentSorted", NULL, n/5, 0}
+            {"Aleatorio", "Aleatorio", "random", 0},
+            {"Ordenado", "Ordenado", "sorted", 0},
+            {"Inverso", "Inverso", "reverse", 0},
+            {"K-sorted (k=10%)", "K-sorted", "ksorted", n/10},
+            {"Nearly Sorted (5% swaps)", "NearlySorted", "nearly_sorted", n/20},
+            {"Con Duplicados (20 únicos)", "Duplicados", "duplicates", 20},
+            {"Plateau (10 segmentos)", "Plateau", "plateau", n/10},
+            {"Segment Sorted (5 segmentos)", "SegmentSorted", "segmentsorted", n/5},
+            // Production-like distributions (values in [0, 1000000])
+            {"Streams intercalados (8 productores)", "Streams", "interleaved_streams", 8},
+            {"Sierra (100 dientes)", "Sawtooth", "sawtooth", 100},
+            {"Organ pipe", "OrganPipe", "organ_pipe", 0},
+            {"Zipf (s=1, 1000 claves)", "Zipf", "zipf", 1000},
+            {"Ordenado + cola aleatoria (1%)", "SortedTail", "sorted_tail", n/100},
+            {"Reinicios periodicos (10 tramos)", "Resets", "periodic_resets", n/10}
         };
         
         int num_test_cases = sizeof(test_cases) / sizeof(test_cases[0]);
@@ -419,44 +468,41 @@ int main(int argc, char* argv[]) {
         for (int tc = 0; tc < num_test_cases; tc++) {
             printf("\n[TEST] %s:\n", test_cases[tc].name);
             
-            // Try to load dataset first
+            // Always generate, so the LCG stream (and every later case) is the
+            // same whether or not a dataset file replaces this one
+            size_t p = test_cases[tc].param1;
+            switch (tc) {
+                case 0: generate_random_array(arr, n, 0, 1000); break;
+                case 1: generate_sorted_array(arr, n, 0, 1000); break;
+                case 2: generate_reverse_array(arr, n, 0, 1000); break;
+                case 3: generate_k_sorted_array(arr, n, (int)p, 0, 1000); break;
+                case 4: generate_nearly_sorted_array(arr, n, p, 0, 1000); break;
+                case 5: generate_duplicates_array(arr, n, (int)p, 0, 100); break;
+                case 6: generate_plateau_array(arr, n, p, 0, 1000); break;
+                case 7: generate_segment_sorted_array(arr, n, p, 0, 1000); break;
+                case 8: generate_interleaved_streams_array(arr, n, p, 0, 1000000); break;
+                case 9: generate_sawtooth_array(arr, n, p, 0, 1000000); break;
+                case 10: generate_organ_pipe_array(arr, n, 0, 1000000); break;
+                case 11: generate_zipf_array(arr, n, p, 0, 1000000); break;
+                case 12: generate_sorted_random_tail_array(arr, n, p, 0, 1000000); break;
+                case 13: generate_periodic_resets_array(arr, n, p, 0, 1000000); break;
+            }
+
             char filename[256];
-            snprintf(filename, sizeof(filename), "../../datasets/%s_%zu.dat", test_cases[tc].short_name, n);
-            // Conversion to lowercase for filename matching if needed, but python script uses:
-            // random, sorted, reverse, ksorted, nearly_sorted, duplicates, plateau
-            // Our short_names are: Aleatorio, Ordenado, Inverso, K-sorted, NearlySorted, Duplicados, Plateau, SegmentSorted
-            // We need to map them.
-            
-            const char* file_suffix = "";
-            if (strcmp(test_cases[tc].short_name, "Aleatorio") == 0) file_suffix = "random";
-            else if (strcmp(test_cases[tc].short_name, "Ordenado") == 0) file_suffix = "sorted";
-            else if (strcmp(test_cases[tc].short_name, "Inverso") == 0) file_suffix = "reverse";
-            else if (strcmp(test_cases[tc].short_name, "K-sorted") == 0) file_suffix = "ksorted";
-            else if (strcmp(test_cases[tc].short_name, "NearlySorted") == 0) file_suffix = "nearly_sorted";
-            else if (strcmp(test_cases[tc].short_name, "Duplicados") == 0) file_suffix = "duplicates";
-            else if (strcmp(test_cases[tc].short_name, "Plateau") == 0) file_suffix = "plateau";
-            else if (strcmp(test_cases[tc].short_name, "SegmentSorted") == 0) file_suffix = "segmentsorted"; // Not generated by script yet?
-            
-            snprintf(filename, sizeof(filename), "../../datasets/%s_%zu.dat", file_suffix, n);
-            
-            int loaded = 0;
-            if (strlen(file_suffix) > 0) {
-                loaded = load_dataset(filename, arr, n);
+            if (export_dir) {
+                snprintf(filename, sizeof(filename), "%s/%s_%zu.dat", export_dir, test_cases[tc].stem, n);
+                if (export_dataset(filename, arr, n)) {
+                    printf("   [EXPORT] %s\n", filename);
+                }
+                continue;
             }
-            
-            if (loaded) {
+
+            // Prefer the shared dataset file if present
+            snprintf(filename, sizeof(filename), "%s/%s_%zu.dat", datasets_dir, test_cases[tc].stem, n);
+            if (load_dataset(filename, arr, n)) {
                  printf("   [INFO] Dataset cargado desde %s\n", filename);
             } else {
-                 printf("   [INFO] Generando datos dinamicamente...\n");
-                 // Generate test data (Fallback)
-                 if (tc == 0) generate_random_array(arr, n, 0, 1000);
-                 else if (tc == 1) generate_sorted_array(arr, n, 0, 1000);
-                 else if (tc == 2) generate_reverse_array(arr, n, 0, 1000);
-                 else if (tc == 3) generate_k_sorted_array(arr, n, test_cases[tc].param1, 0, 1000);
-                 else if (tc == 4) generate_nearly_sorted_array(arr, n, test_cases[tc].param1, 0, 1000);
-                 else if (tc == 5) generate_duplicates_array(arr, n, test_cases[tc].param1, 0, 100);
-                 else if (tc == 6) generate_plateau_array(arr, n, test_cases[tc].param1, 0, 1000);
-                 else if (tc == 7) generate_segment_sorted_array(arr, n, test_cases[tc].param1, 0, 1000);
+                 printf("   [INFO] Datos generados (seed %lu)\n", seed);
             }
             
             // Generate reference result with qsort
@@ -507,6 +553,14 @@ int main(int argc, char* argv[]) {
                     }
                     if (result.success) {
                         result.stats = calculate_stats(result.times, repetitions);
+
+                        // Memory: libc's internal qsort buffer only shows up in maxrss
+                        int* temp = (int*)malloc(n * sizeof(int));
+                        memcpy(temp, arr, n * sizeof(int));
+                        alloc_tracker_begin();
+                        qsort(temp, n, sizeof(int), qsort_cmp);
+                        result.memory = alloc_tracker_end();
+                        free(temp);
                     }
                 } else {
                     result = run_benchmark(alg_names[alg], alg_funcs[alg], arr, n, 
@@ -522,6 +576,8 @@ int main(int argc, char* argv[]) {
                          alg_names[alg], n, test_cases[tc].short_name,
                          result.stats.mean, result.stats.median, result.stats.std,
                          status, validation_info);
+                    printf("     memoria: pico aux %zu bytes | %zu allocs | maxrss +%ld KB\n",
+                         result.memory.peak_bytes, result.memory.allocations, result.memory.maxrss_delta_kb);
                 } else {
                     printf("   %-25s | %6zu | %-18s | %9s | %11s | %8s | %s\n",
                          alg_names[alg], n, test_cases[tc].short_name,
@@ -537,6 +593,12 @@ int main(int argc, char* argv[]) {
         free(reference);
     }
     
+    if (export_dir) {
+        printf("\n[*] Datasets exportados a %s\n", export_dir);
+        free(all_results);
+        return 0;
+    }
+
     printf("\n====================================================================================================\n");
     printf("[*] Benchmarks completados!\n\n");
     
@@ -1,13 +1,20 @@
 #include "generators.h"
 #include <stdio.h>
+#include <stdlib.h>
 
 // --- LCG Random Number Generator ---
+static unsigned long lcg_initial_seed = 12345;
 static unsigned long lcg_seed = 12345;
 
 void set_seed(unsigned long seed) {
+    lcg_initial_seed = seed;
     lcg_seed = seed;
 }
 
+unsigned long get_seed(void) {
+    return lcg_initial_seed;
+}
+
 double lcg_random() {
     const unsigned long a = 1103515245;
     const unsigned long c = 12345;
@@ -36,6 +43,17 @@ int load_dataset(const char* filename, int* arr, size_t n) {
     return 1; // Success
 }
 
+int export_dataset(const char* filename, const int* arr, size_t n) {
+    FILE* f = fopen(filename, "wb");
+    if (!f) {
+        printf("[ERROR] No se pudo crear el archivo de dataset: %s\n", filename);
+        return 0;
+    }
+    size_t written = fwrite(arr, sizeof(int), n, f);
+    fclose(f);
+    return written == n;
+}
+
 // --- Data Generators ---
 void generate_random_array(int* arr, size_t n, int min, int max) {
     for (size_t i = 0; i < n; i++) {
@@ -53,7 +71,7 @@ void generate_sorted_array(int* arr, size_t n, int min, int max) {
 void generate_reverse_array(int* arr, size_t n, int min, int max) {
     double step = (double)(max - min) / n;
     for (size_t i = 0; i < n; i++) {
-        arr[i] = max - (int)(i * step);
+        arr[i] = (int)(max - i * step); // Truncate like generate_datasets.py and C++
     }
 }
 
@@ -125,3 +143,100 @@ void generate_segment_sorted_array(int* arr, size_t n, size_t segment_size, int
         idx = segment_end;
     }
 }
+
+// --- Production-like distributions ---
+
+// N producers with skewed clocks appending non-decreasing timestamps to one
+// log; each element comes from a random producer. Every producer advances
+// (max - min) in total, on average.
+void generate_interleaved_streams_array(int* arr, size_t n, size_t num_streams, int min, int max) {
+    if (num_streams == 0) num_streams = 1;
+    double* clocks = (double*)malloc(num_streams * sizeof(double));
+    if (!clocks) return;
+    double gap = (double)(max - min) * num_streams / n;
+
+    for (size_t s = 0; s < num_streams; s++) {
+        clocks[s] = min + lcg_random() * (max - min) / 100; // Up to 1% clock skew
+    }
+    for (size_t i = 0; i < n; i++) {
+        size_t s = (size_t)(lcg_random() * num_streams);
+        clocks[s] += lcg_random() * 2 * gap;
+        arr[i] = (int)clocks[s];
+    }
+    free(clocks);
+}
+
+// num_teeth ascending ramps from min to max
+void generate_sawtooth_array(int* arr, size_t n, size_t num_teeth, int min, int max) {
+    if (num_teeth == 0) num_teeth = 1;
+    size_t tooth = (n + num_teeth - 1) / num_teeth;
+    for (size_t i = 0; i < n; i++) {
+        arr[i] = min + (int)((double)(max - min) * (i % tooth) / tooth);
+    }
+}
+
+// Ascending to the middle, then the mirror image descending
+void generate_organ_pipe_array(int* arr, size_t n, int min, int max) {
+    size_t half = (n + 1) / 2;
+    for (size_t i = 0; i < n; i++) {
+        size_t d = (i < n - 1 - i) ? i : n - 1 - i;
+        arr[i] = min + (int)((double)(max - min) * d / half);
+    }
+}
+
+// Zipf (s = 1) over num_keys keys. Ranks are scattered over [min, max) by a
+// multiplicative hash so the hot keys are not simply the smallest values.
+void generate_zipf_array(int* arr, size_t n, size_t num_keys, int min, int max) {
+    if (num_keys == 0) num_keys = 1;
+    double* cdf = (double*)malloc(num_keys * sizeof(double));
+    if (!cdf) return;
+
+    double total = 0.0;
+    for (size_t k = 0; k < num_keys; k++) {
+        total += 1.0 / (double)(k + 1);
+        cdf[k] = total;
+    }
+    for (size_t k = 0; k < num_keys; k++) {
+        cdf[k] /= total;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        double u = lcg_random();
+        // First rank with u < cdf[rank]
+        size_t lo = 0, hi = num_keys - 1;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (u < cdf[mid]) hi = mid;
+            else lo = mid + 1;
+        }
+        unsigned long long key = ((unsigned long long)lo * 2654435761ULL) % num_keys;
+        arr[i] = min + (int)((double)(max - min) * key / num_keys);
+    }
+    free(cdf);
+}
+
+// Sorted prefix followed by tail_size random appends
+void generate_sorted_random_tail_array(int* arr, size_t n, size_t tail_size, int min, int max) {
+    if (tail_size > n) tail_size = n;
+    size_t head = n - tail_size;
+    generate_sorted_array(arr, head, min, max);
+    for (size_t i = head; i < n; i++) {
+        arr[i] = min + (int)(lcg_random() * (max - min + 1));
+    }
+}
+
+// Jittered counter climbing from ~min to ~max that restarts every `period`
+// elements (sequence numbers with rollovers, per-day logs concatenated)
+void generate_periodic_resets_array(int* arr, size_t n, size_t period, int min, int max) {
+    if (period == 0) period = 1;
+    double step = (double)(max - min) / period;
+    double value = min;
+    for (size_t i = 0; i < n; i++) {
+        if (i % period == 0) {
+            value = min + lcg_random() * (max - min) / 100;
+        } else {
+            value += lcg_random() * 2 * step;
+        }
+        arr[i] = (int)value;
+    }
+}
@@ -5,10 +5,12 @@
 
 // --- LCG Random Number Generator ---
 void set_seed(unsigned long seed);
+unsigned long get_seed(void); // Seed given to set_seed() (not the current state)
 double lcg_random();
 
-// --- Dataset Loader ---
+// --- Dataset Loader / Export (raw native-endian int32, <stem>_<size>.dat) ---
 int load_dataset(const char* filename, int* arr, size_t n);
+int export_dataset(const char* filename, const int* arr, size_t n);
 
 // --- Data Generators ---
 void generate_random_array(int* arr, size_t n, int min, int max);
@@ -20,4 +22,14 @@ void generate_duplicates_array(int* arr, size_t n, int unique_values, int min, i
 void generate_plateau_array(int* arr, size_t n, size_t plateau_size, int min, int max);
 void generate_segment_sorted_array(int* arr, size_t n, size_t segment_size, int min, int max);
 
+// --- Production-like distributions ---
+// Same LCG call sequence as the C++ generators in cpp_benchmarks.cpp, so a
+// given seed produces identical arrays in both harnesses.
+void generate_interleaved_streams_array(int* arr, size_t n, size_t num_streams, int min, int max);
+void generate_sawtooth_array(int* arr, size_t n, size_t num_teeth, int min, int max);
+void generate_organ_pipe_array(int* arr, size_t n, int min, int max);
+void generate_zipf_array(int* arr, size_t n, size_t num_keys, int min, int max);
+void generate_sorted_random_tail_array(int* arr, size_t n, size_t tail_size, int min, int max);
+void generate_periodic_resets_array(int* arr, size_t n, size_t period, int min, int max);
+
 #endif // GENERATORS_H
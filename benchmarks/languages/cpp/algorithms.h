@@ -0,0 +1,32 @@
+/** @author Sebastian Wild (wild@liverpool.ac.uk) */
+
+// Reduced to what powersort.h needs: the sorter interface of the upstream
+// nearly-optimal-mergesort-code repository (src/algorithms.h).
+
+#ifndef MERGESORTS_ALGORITHMS_H
+#define MERGESORTS_ALGORITHMS_H
+
+#include <iterator>
+#include <string>
+
+namespace algorithms {
+
+	/**
+	 * Common interface of the sorting methods; sort(begin, end) sorts
+	 * [begin,end) in place.
+	 */
+	template<typename Iterator>
+	class sorter {
+	protected:
+		using elem_t = typename std::iterator_traits<Iterator>::value_type;
+		using diff_t = typename std::iterator_traits<Iterator>::difference_type;
+
+	public:
+		virtual void sort(Iterator begin, Iterator end) = 0;
+		virtual std::string name() const = 0;
+		virtual ~sorter() = default;
+	};
+
+}
+
+#endif //MERGESORTS_ALGORITHMS_H
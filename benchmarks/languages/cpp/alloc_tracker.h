@@ -0,0 +1,156 @@
+/**
+ * Allocation Tracking for C++ Benchmarks
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Replaces the global operator new/delete with counting versions, so every
+ * std::vector/buffer an algorithm allocates is seen. Each block carries a
+ * small size prefix; delete subtracts it, which gives an exact peak of live
+ * heap bytes. getrusage's maxrss delta is reported alongside (the kernel's
+ * peak RSS is reset through /proc/self/clear_refs where permitted).
+ *
+ * The replacement functions are defined here, so include this header from
+ * exactly ONE translation unit of a program. Counters are not atomic: the
+ * benchmarks are single-threaded.
+ *
+ * Usage:
+ *   alloc::begin();
+ *   sort(...);
+ *   alloc::MemoryUsage m = alloc::end();
+ */
+
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <new>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// Kept out of line: once inlined into delete-expressions, GCC flags the
+// prefix arithmetic and the malloc/free pairing as new/delete mismatches
+#if defined(__GNUC__)
+#define ALLOC_TRACKER_NOINLINE __attribute__((noinline))
+#else
+#define ALLOC_TRACKER_NOINLINE
+#endif
+
+namespace alloc {
+
+    struct MemoryUsage {
+        size_t peak_bytes = 0;      // Peak live bytes above the level at begin()
+        size_t allocations = 0;     // operator new calls
+        size_t allocated_bytes = 0; // Sum of requested bytes
+        long maxrss_delta_kb = 0;   // Growth of the process peak RSS, in KB
+    };
+
+    // Size prefix, padded to keep the returned pointer maximally aligned
+    const size_t HEADER_SIZE = alignof(std::max_align_t);
+
+    struct State {
+        size_t live_bytes = 0;
+        size_t base = 0;
+        size_t peak = 0;
+        size_t allocations = 0;
+        size_t allocated = 0;
+        long maxrss_kb = 0;
+    };
+
+    inline State& state() {
+        static State s;
+        return s;
+    }
+
+    ALLOC_TRACKER_NOINLINE inline void* allocate(size_t size) {
+        void* block = std::malloc(size + HEADER_SIZE);
+        if (!block) return nullptr;
+        std::memcpy(block, &size, sizeof(size));
+        State& s = state();
+        s.live_bytes += size;
+        s.allocations++;
+        s.allocated += size;
+        if (s.live_bytes > s.peak) s.peak = s.live_bytes;
+        return static_cast<unsigned char*>(block) + HEADER_SIZE;
+    }
+
+    ALLOC_TRACKER_NOINLINE inline void deallocate(void* ptr) {
+        if (!ptr) return;
+        unsigned char* block = static_cast<unsigned char*>(ptr) - HEADER_SIZE;
+        size_t size;
+        std::memcpy(&size, block, sizeof(size));
+        state().live_bytes -= size;
+        std::free(block);
+    }
+
+    // Helper: process peak RSS in KB (0 where getrusage is unavailable)
+    inline long peakRssKb() {
+#ifndef _WIN32
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0) return usage.ru_maxrss;
+#endif
+        return 0;
+    }
+
+    // Start a measurement window
+    inline void begin() {
+#ifdef __linux__
+        // "5" resets the peak RSS (Linux >= 4.0); otherwise the delta is
+        // measured against the previous high-water mark and may read 0
+        if (FILE* f = std::fopen("/proc/self/clear_refs", "w")) {
+            std::fputs("5", f);
+            std::fclose(f);
+        }
+#endif
+        State& s = state();
+        s.base = s.live_bytes;
+        s.peak = s.live_bytes;
+        s.allocations = 0;
+        s.allocated = 0;
+        s.maxrss_kb = peakRssKb();
+    }
+
+    inline MemoryUsage end() {
+        const State& s = state();
+        MemoryUsage usage;
+        usage.peak_bytes = s.peak - s.base;
+        usage.allocations = s.allocations;
+        usage.allocated_bytes = s.allocated;
+        usage.maxrss_delta_kb = peakRssKb() - s.maxrss_kb;
+        return usage;
+    }
+
+} // namespace alloc
+
+// Replacement allocation functions (unaligned forms; over-aligned types keep
+// the library versions and are not counted)
+void* operator new(size_t size) {
+    if (void* ptr = alloc::allocate(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    if (void* ptr = alloc::allocate(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return alloc::allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return alloc::allocate(size);
+}
+
+void operator delete(void* ptr) noexcept { alloc::deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { alloc::deallocate(ptr); }
+void operator delete(void* ptr, size_t) noexcept { alloc::deallocate(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { alloc::deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { alloc::deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { alloc::deallocate(ptr); }
+
+#endif // ALLOC_TRACKER_H
@@ -0,0 +1,143 @@
+/**
+ * Argsort Benchmark - Block Merge Segment Sort
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Computes the stable sorting permutation of a read-only column:
+ * - segment_sort::argsort with uint32_t and uint64_t indices
+ * - block_merge_segment_sort on an iota index array with an indirect
+ *   comparator (no direct run detection, no prefetching)
+ * - std::stable_sort on an iota index array (reference)
+ *
+ * Every result is checked against the std::stable_sort permutation.
+ *
+ * Build: g++ -O2 -std=c++17 benchmark_argsort.cpp -o benchmark_argsort
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <string>
+#include <numeric>
+#include <cstdint>
+
+#include "../../../implementations/cpp/block_merge_segment_sort.h"
+#include "../../../implementations/cpp/argsort.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// --- Data ---
+
+void fill_random(vector<double>& arr) {
+    mt19937 gen(42);
+    uniform_int_distribution<> dis(1, 1000000);
+    for (auto& x : arr) x = dis(gen);
+}
+
+void fill_sorted(vector<double>& arr) {
+    for (size_t i = 0; i < arr.size(); ++i) arr[i] = static_cast<double>(i);
+}
+
+void fill_reverse(vector<double>& arr) {
+    for (size_t i = 0; i < arr.size(); ++i) arr[i] = static_cast<double>(arr.size() - i);
+}
+
+void fill_nearly_sorted(vector<double>& arr) {
+    fill_sorted(arr);
+    size_t n = arr.size();
+    mt19937 gen(42);
+    uniform_int_distribution<size_t> dis(0, n - 1);
+    for (size_t i = 0; i < n / 100; ++i) {
+        swap(arr[dis(gen)], arr[dis(gen)]);
+    }
+}
+
+void fill_few_unique(vector<double>& arr) {
+    mt19937 gen(42);
+    uniform_int_distribution<> dis(0, 9);
+    for (auto& x : arr) x = dis(gen);
+}
+
+// --- Runner ---
+
+template<typename IndexT, typename SortFn>
+double time_argsort(const vector<uint32_t>& expected, SortFn sort_fn, int reps) {
+    vector<IndexT> perm(expected.size());
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        auto start = high_resolution_clock::now();
+        sort_fn(perm);
+        auto end = high_resolution_clock::now();
+        best = min(best, duration_cast<duration<double, milli>>(end - start).count());
+        if (r == 0 && !equal(perm.begin(), perm.end(), expected.begin())) {
+            cerr << "Permutation mismatch!" << endl;
+            exit(1);
+        }
+    }
+    return best;
+}
+
+void run_test(const string& name, void (*fill_func)(vector<double>&), size_t n, int reps) {
+    vector<double> data(n);
+    fill_func(data);
+    const double* col = data.data();
+    auto less_at = [col](uint32_t a, uint32_t b) { return col[a] < col[b]; };
+
+    vector<uint32_t> expected(n);
+    iota(expected.begin(), expected.end(), 0u);
+    stable_sort(expected.begin(), expected.end(), less_at);
+
+    double t32 = time_argsort<uint32_t>(expected, [&](vector<uint32_t>& p) {
+        segment_sort::argsort(col, n, p.data());
+    }, reps);
+    double t64 = time_argsort<uint64_t>(expected, [&](vector<uint64_t>& p) {
+        segment_sort::argsort(col, n, p.data());
+    }, reps);
+    double tgen = time_argsort<uint32_t>(expected, [&](vector<uint32_t>& p) {
+        iota(p.begin(), p.end(), 0u);
+        segment_sort::block_merge_segment_sort(p.data(), n, BLOCK_MERGE_DEFAULT_BUFFER_SIZE, less_at);
+    }, reps);
+    double tstd = time_argsort<uint32_t>(expected, [&](vector<uint32_t>& p) {
+        iota(p.begin(), p.end(), 0u);
+        stable_sort(p.begin(), p.end(), less_at);
+    }, reps);
+
+    cout << left << setw(14) << name << " | " << fixed << setprecision(2) << right
+         << setw(10) << t32 << " | "
+         << setw(10) << t64 << " | "
+         << setw(12) << tgen << " | "
+         << setw(12) << tstd << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t size = 1000000;
+    int reps = 5;
+    if (argc > 1) {
+        try {
+            size = std::stoull(argv[1]);
+        } catch (...) {
+            std::cerr << "Invalid size argument. Using default: " << size << std::endl;
+        }
+    }
+
+    cout << "\n==================================================================" << endl;
+    cout << "   Argsort Benchmark (" << size << " doubles, best of " << reps << ", ms)" << endl;
+    cout << "==================================================================" << endl;
+    cout << left << setw(14) << "Data Type" << " | " << right
+         << setw(10) << "argsort32" << " | "
+         << setw(10) << "argsort64" << " | "
+         << setw(12) << "bmss(iota)" << " | "
+         << setw(12) << "stable(iota)" << endl;
+    cout << "------------------------------------------------------------------" << endl;
+    run_test("Random", fill_random, size, reps);
+    run_test("Sorted", fill_sorted, size, reps);
+    run_test("Reverse", fill_reverse, size, reps);
+    run_test("Nearly Sorted", fill_nearly_sorted, size, reps);
+    run_test("Few Unique", fill_few_unique, size, reps);
+    cout << "==================================================================" << endl;
+    return 0;
+}
@@ -0,0 +1,210 @@
+/**
+ * Algorithm Selection Benchmark - Block Merge Segment Sort
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Calibrates the decision table of segment_sort::sort (auto_sort.h):
+ * 1. The presortedness measures of segment_sort::analyze per input.
+ * 2. The time of segment_sort::sort (and the algorithm it picked) next to
+ *    every candidate run directly: block merge, counting sort, radix sort,
+ *    pdqsort, plus std::sort for reference.
+ *
+ * Inputs: random, sorted, reversed, nearly sorted (1% swaps), k-sorted
+ * (k = 64 and 4096), sawtooth (runs of 1000), 20 distinct values spread
+ * over the int range, and a small range (values % 1000). Sorted, reversed,
+ * nearly sorted and k-sorted keys are i * KEY_STRIDE, so their range is
+ * too wide for counting sort and they exercise the other rows.
+ *
+ * Build: g++ -O2 -std=c++17 benchmark_auto_sort.cpp -o benchmark_auto_sort
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <string>
+#include <numeric>
+#include <cstdint>
+
+#include "../../../implementations/cpp/block_merge_segment_sort.h"
+#include "../../../implementations/cpp/auto_sort.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// --- Data ---
+
+// Spacing of the ordered keys (1M * 1021 still fits in int32)
+const int KEY_STRIDE = 1021;
+
+template<typename T>
+void fill_strided(vector<T>& arr) {
+    for (size_t i = 0; i < arr.size(); ++i) arr[i] = static_cast<T>(i) * KEY_STRIDE;
+}
+
+template<typename T>
+void fill_random(vector<T>& arr) {
+    mt19937_64 gen(42);
+    for (auto& x : arr) x = static_cast<T>(gen());
+}
+
+template<typename T>
+void fill_sorted(vector<T>& arr) {
+    fill_strided(arr);
+}
+
+template<typename T>
+void fill_reversed(vector<T>& arr) {
+    fill_strided(arr);
+    reverse(arr.begin(), arr.end());
+}
+
+template<typename T>
+void fill_nearly_sorted(vector<T>& arr) {
+    fill_strided(arr);
+    mt19937 gen(42);
+    uniform_int_distribution<size_t> dis(0, arr.size() - 1);
+    for (size_t i = 0; i < arr.size() / 100; ++i) swap(arr[dis(gen)], arr[dis(gen)]);
+}
+
+// Every element at most ~K places from its sorted position
+template<typename T, size_t K>
+void fill_k_sorted(vector<T>& arr) {
+    fill_strided(arr);
+    mt19937 gen(42);
+    for (size_t i = 0; i + 1 < arr.size(); ++i) swap(arr[i], arr[min(arr.size() - 1, i + gen() % K)]);
+}
+
+template<typename T>
+void fill_sawtooth(vector<T>& arr) {
+    for (size_t i = 0; i < arr.size(); ++i) arr[i] = static_cast<T>(i % 1000);
+}
+
+template<typename T>
+void fill_few_unique(vector<T>& arr) {
+    mt19937 gen(42);
+    for (auto& x : arr) x = static_cast<T>((gen() % 20) * 100000007ull);
+}
+
+template<typename T>
+void fill_small_range(vector<T>& arr) {
+    mt19937 gen(42);
+    for (auto& x : arr) x = static_cast<T>(gen() % 1000);
+}
+
+// --- Timing ---
+
+template<typename T, typename SortFn>
+double time_sort(const vector<T>& original, const vector<T>& expected, SortFn sort_fn, int reps) {
+    vector<T> copy(original.size());
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        copy = original;
+        auto start = high_resolution_clock::now();
+        sort_fn(copy);
+        auto end = high_resolution_clock::now();
+        best = min(best, duration_cast<duration<double, milli>>(end - start).count());
+        if (r == 0 && copy != expected) {
+            cerr << "Validation failed!" << endl;
+            exit(1);
+        }
+    }
+    return best;
+}
+
+template<typename T>
+void run_case(const string& name, void (*fill_func)(vector<T>&), size_t n, int reps) {
+    vector<T> data(n);
+    fill_func(data);
+    vector<T> expected = data;
+    std::sort(expected.begin(), expected.end());
+
+    const segment_sort::Presortedness p = segment_sort::analyze(data.begin(), data.end());
+    const segment_sort::SortAlgorithm choice = segment_sort::choose_algorithm(p);
+
+    double t_analyze = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        auto start = high_resolution_clock::now();
+        volatile size_t sink = segment_sort::analyze(data.begin(), data.end()).runs;
+        (void)sink;
+        auto end = high_resolution_clock::now();
+        t_analyze = min(t_analyze, duration_cast<duration<double, milli>>(end - start).count());
+    }
+
+    double t_auto = time_sort(data, expected, [](vector<T>& a) { segment_sort::sort(a); }, reps);
+    double t_block = time_sort(data, expected, [](vector<T>& a) { segment_sort::block_merge_segment_sort(a); }, reps);
+    double t_radix = time_sort(data, expected, [](vector<T>& a) { segment_sort::radix_sort(a.data(), a.size()); }, reps);
+    double t_pdq = time_sort(data, expected, [](vector<T>& a) { pdqsort_branchless(a.begin(), a.end()); }, reps);
+    double t_std = time_sort(data, expected, [](vector<T>& a) { std::sort(a.begin(), a.end()); }, reps);
+
+    cout << left << setw(15) << name << " | " << right << fixed << setprecision(1)
+         << setw(6) << p.avg_run_length << " | " << setprecision(2)
+         << setw(5) << p.descending_fraction << " | "
+         << setw(5) << p.duplicate_ratio << " | "
+         << setw(5) << p.inversion_ratio << " | "
+         << left << setw(11) << segment_sort::sort_algorithm_name(choice) << " | " << right << setprecision(3)
+         << setw(7) << t_analyze << " | "
+         << setw(8) << t_auto << " | "
+         << setw(8) << t_block << " | ";
+    if (p.key_range < segment_sort::SortDecisionTable().counting_max_range) {
+        double t_count = time_sort(data, expected, [&p](vector<T>& a) {
+            segment_sort::counting_sort(a.data(), a.size(), *min_element(a.begin(), a.end()), p.key_range);
+        }, reps);
+        cout << setw(8) << t_count << " | ";
+    } else {
+        cout << setw(8) << "-" << " | ";
+    }
+    cout << setw(8) << t_radix << " | "
+         << setw(8) << t_pdq << " | "
+         << setw(8) << t_std << endl;
+}
+
+template<typename T>
+void run_size(const string& type_name, size_t n, int reps) {
+    cout << "\n=====================================================================================================================" << endl;
+    cout << "   " << type_name << ", " << n << " elements (best of " << reps << ", ms)" << endl;
+    cout << "=====================================================================================================================" << endl;
+    cout << left << setw(15) << "Data Type" << " | " << right
+         << setw(6) << "avgrun" << " | "
+         << setw(5) << "desc" << " | "
+         << setw(5) << "dups" << " | "
+         << setw(5) << "inv" << " | "
+         << left << setw(11) << "choice" << " | " << right
+         << setw(7) << "analyze" << " | "
+         << setw(8) << "sort()" << " | "
+         << setw(8) << "block" << " | "
+         << setw(8) << "counting" << " | "
+         << setw(8) << "radix" << " | "
+         << setw(8) << "pdqsort" << " | "
+         << setw(8) << "std" << endl;
+    cout << "---------------------------------------------------------------------------------------------------------------------" << endl;
+    run_case<T>("Random", fill_random<T>, n, reps);
+    run_case<T>("Sorted", fill_sorted<T>, n, reps);
+    run_case<T>("Reversed", fill_reversed<T>, n, reps);
+    run_case<T>("Nearly Sorted", fill_nearly_sorted<T>, n, reps);
+    run_case<T>("K-Sorted 64", fill_k_sorted<T, 64>, n, reps);
+    run_case<T>("K-Sorted 4096", fill_k_sorted<T, 4096>, n, reps);
+    run_case<T>("Sawtooth", fill_sawtooth<T>, n, reps);
+    run_case<T>("Few Unique", fill_few_unique<T>, n, reps);
+    run_case<T>("Small Range", fill_small_range<T>, n, reps);
+}
+
+int main(int argc, char* argv[]) {
+    vector<size_t> sizes = {1000, 4096, 65536, 1000000};
+    int reps = 5;
+    if (argc > 1) {
+        try {
+            sizes = {std::stoull(argv[1])};
+        } catch (...) {
+            std::cerr << "Invalid size argument. Using the default sizes" << std::endl;
+        }
+    }
+
+    for (size_t n : sizes) {
+        run_size<int32_t>("int32", n, reps);
+        run_size<int64_t>("int64", n, reps);
+    }
+    return 0;
+}
@@ -0,0 +1,167 @@
+/**
+ * K-Way Merge Benchmark - Block Merge Segment Sort
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Merges K sorted int64 inputs (N elements in total) for K = 2 ... 4096:
+ * - merge_k (loser tree + galloping bulk copies) and merge_k<0> (no galloping)
+ * - parallel_merge_k (co-ranked output slices, hardware concurrency threads)
+ * - a binary heap of input cursors (std::priority_queue), the approach of
+ *   segmentsort.cpp and SegmentSort::Iterator
+ * - block_merge_segment_sort and std::sort of the concatenated inputs
+ *
+ * Inputs: "Interleaved" draws every input from the same uniform random
+ * keys, so the winner changes almost every element. "Blocks" cuts the
+ * sorted sequence into blocks of 1000 consecutive keys dealt to random
+ * inputs, so long stretches come from one input and galloping pays off.
+ *
+ * Build: g++ -O2 -std=c++17 -pthread benchmark_merge_k.cpp -o benchmark_merge_k
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <string>
+#include <queue>
+#include <thread>
+#include <cstdint>
+
+#include "../../../implementations/cpp/block_merge_segment_sort.h"
+#include "../../../implementations/cpp/merge_k.h"
+
+using namespace std;
+using namespace std::chrono;
+
+using Key = int64_t;
+using Inputs = vector<vector<Key>>;
+
+const size_t BLOCK_LENGTH = 1000;
+
+// --- Data ---
+
+void make_interleaved(Inputs& inputs, size_t n) {
+    mt19937_64 gen(42);
+    const size_t k = inputs.size();
+    for (size_t i = 0; i < k; ++i) {
+        inputs[i].resize(n / k + (i < n % k ? 1 : 0));
+        for (auto& x : inputs[i]) x = static_cast<Key>(gen() >> 1);
+        sort(inputs[i].begin(), inputs[i].end());
+    }
+}
+
+void make_blocks(Inputs& inputs, size_t n) {
+    mt19937_64 gen(42);
+    for (size_t start = 0; start < n; start += BLOCK_LENGTH) {
+        auto& input = inputs[gen() % inputs.size()];
+        for (size_t j = start; j < min(n, start + BLOCK_LENGTH); ++j) input.push_back(static_cast<Key>(j));
+    }
+}
+
+// --- Competitors ---
+
+// Min-heap of (head value, input index) cursors, ties to the lower index
+void heap_merge(const vector<segment_sort::SortedSpan<Key>>& spans, Key* out) {
+    using Entry = pair<Key, size_t>;
+    priority_queue<Entry, vector<Entry>, greater<Entry>> heap;
+    vector<size_t> pos(spans.size(), 0);
+    for (size_t i = 0; i < spans.size(); ++i) {
+        if (spans[i].size > 0) heap.push({spans[i].data[0], i});
+    }
+    while (!heap.empty()) {
+        const size_t i = heap.top().second;
+        heap.pop();
+        *out++ = spans[i].data[pos[i]++];
+        if (pos[i] < spans[i].size) heap.push({spans[i].data[pos[i]], i});
+    }
+}
+
+void concatenate(const Inputs& inputs, vector<Key>& out) {
+    Key* dst = out.data();
+    for (const auto& input : inputs) dst = copy(input.begin(), input.end(), dst);
+}
+
+// --- Timing ---
+
+template<typename Fn>
+double time_merge(vector<Key>& out, const vector<Key>& expected, Fn fn, int reps) {
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        fill(out.begin(), out.end(), Key(0));
+        auto start = high_resolution_clock::now();
+        fn();
+        auto end = high_resolution_clock::now();
+        best = min(best, duration_cast<duration<double, milli>>(end - start).count());
+        if (r == 0 && out != expected) {
+            cerr << "Validation failed!" << endl;
+            exit(1);
+        }
+    }
+    return best;
+}
+
+void run_case(const string& name, void (*make)(Inputs&, size_t), size_t k, size_t n, int reps) {
+    Inputs inputs(k);
+    make(inputs, n);
+    vector<segment_sort::SortedSpan<Key>> spans(inputs.begin(), inputs.end());
+
+    vector<Key> expected(n);
+    concatenate(inputs, expected);
+    sort(expected.begin(), expected.end());
+    vector<Key> out(n);
+
+    double t_merge = time_merge(out, expected, [&]() { segment_sort::merge_k(spans, out.data()); }, reps);
+    double t_plain = time_merge(out, expected, [&]() { segment_sort::merge_k<0>(spans, out.data()); }, reps);
+    double t_parallel = time_merge(out, expected, [&]() { segment_sort::parallel_merge_k(spans, out.data()); }, reps);
+    double t_heap = time_merge(out, expected, [&]() { heap_merge(spans, out.data()); }, reps);
+    double t_block = time_merge(out, expected, [&]() {
+        concatenate(inputs, out);
+        segment_sort::block_merge_segment_sort(out);
+    }, reps);
+    double t_std = time_merge(out, expected, [&]() {
+        concatenate(inputs, out);
+        sort(out.begin(), out.end());
+    }, reps);
+
+    cout << left << setw(12) << name << " | " << right << setw(5) << k << " | " << fixed << setprecision(2)
+         << setw(8) << t_merge << " | "
+         << setw(8) << t_plain << " | "
+         << setw(8) << t_parallel << " | "
+         << setw(8) << t_heap << " | "
+         << setw(8) << t_block << " | "
+         << setw(8) << t_std << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = 1 << 22;
+    int reps = 5;
+    if (argc > 1) {
+        try {
+            n = std::stoull(argv[1]);
+        } catch (...) {
+            std::cerr << "Invalid size argument. Using the default size" << std::endl;
+        }
+    }
+
+    cout << "=====================================================================================" << endl;
+    cout << "   K-way merge of " << n << " int64 (best of " << reps << ", ms, "
+         << max(1u, thread::hardware_concurrency()) << " threads for parallel)" << endl;
+    cout << "=====================================================================================" << endl;
+    cout << left << setw(12) << "Data Type" << " | " << right << setw(5) << "K" << " | "
+         << setw(8) << "merge_k" << " | "
+         << setw(8) << "no gallop" << " | "
+         << setw(8) << "parallel" << " | "
+         << setw(8) << "heap" << " | "
+         << setw(8) << "block" << " | "
+         << setw(8) << "std" << endl;
+    cout << "-------------------------------------------------------------------------------------" << endl;
+    for (auto make : {make_interleaved, make_blocks}) {
+        const string name = make == make_interleaved ? "Interleaved" : "Blocks";
+        for (size_t k = 2; k <= 4096; k *= 2) {
+            run_case(name, make, k, n, reps);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,186 @@
+/**
+ * Merge Policy Benchmark - Block Merge Segment Sort
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Compares the stack merge policies of block_merge_segment_sort
+ * (BalancedMergePolicy, TimSortMergePolicy, PowerSortMergePolicy) on
+ * run-length distributions that stress the "current >= top" rule:
+ * - Descending staircase: run lengths L, L-1, ..., 1 (nothing merges under
+ *   the "current >= top" rule until the final top-down collapse)
+ * - Ascending staircase: run lengths 1, 2, ..., L
+ * - Long + tail: one n/2 run followed by many short runs
+ * - Random lengths: uniform run lengths in [32, 4096]
+ *
+ * For each policy it reports time (int elements) and the total number of
+ * element moves and comparisons (CountedInt elements). The min run
+ * extension is disabled so the natural run lengths reach the policy.
+ *
+ * Build: g++ -O2 -std=c++17 benchmark_merge_policy.cpp -o benchmark_merge_policy
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <string>
+
+#include "../../../implementations/cpp/block_merge_segment_sort.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// --- Instrumented element: counts moves (copies/assignments) and comparisons ---
+
+struct CountedInt {
+    int value = 0;
+    static size_t moves;
+    static size_t comparisons;
+
+    CountedInt() = default;
+    CountedInt(int v) : value(v) {}
+    CountedInt(const CountedInt& o) : value(o.value) { ++moves; }
+    CountedInt& operator=(const CountedInt& o) { value = o.value; ++moves; return *this; }
+
+    friend bool operator<(const CountedInt& a, const CountedInt& b) { ++comparisons; return a.value < b.value; }
+    friend bool operator<=(const CountedInt& a, const CountedInt& b) { ++comparisons; return a.value <= b.value; }
+    friend bool operator>(const CountedInt& a, const CountedInt& b) { ++comparisons; return a.value > b.value; }
+};
+
+size_t CountedInt::moves = 0;
+size_t CountedInt::comparisons = 0;
+
+// --- Run-length distributions ---
+
+// Builds an array made of ascending runs with exactly the given lengths.
+vector<int> build_runs(const vector<size_t>& lengths, mt19937& gen) {
+    uniform_int_distribution<int> dis(0, 1 << 30);
+    vector<int> arr;
+    for (size_t len : lengths) {
+        size_t start = arr.size();
+        for (size_t j = 0; j < len; ++j) arr.push_back(dis(gen));
+        sort(arr.begin() + start, arr.end());
+        // Force a strict descent at the run boundary
+        if (start > 0 && arr[start] >= arr[start - 1]) arr[start] = arr[start - 1] - 1;
+    }
+    return arr;
+}
+
+// Run lengths L, L-1, ..., 1 (descending) or 1, 2, ..., L (ascending), scaled
+// by 32 so runs are not trivially short, with L chosen to fill n.
+vector<size_t> staircase_lengths(size_t n, bool descending) {
+    size_t L = 1;
+    while ((L + 1) * (L + 2) / 2 * 32 <= n) ++L;
+    vector<size_t> lengths;
+    size_t total = 0;
+    for (size_t step = 0; step < L && total < n; ++step) {
+        size_t len = descending ? L - step : step + 1;
+        size_t l = min(len * 32, n - total);
+        lengths.push_back(l);
+        total += l;
+    }
+    if (total < n) lengths.push_back(n - total);
+    return lengths;
+}
+
+vector<size_t> long_tail_lengths(size_t n, mt19937& gen) {
+    vector<size_t> lengths = {n / 2};
+    uniform_int_distribution<size_t> dis(8, 64);
+    size_t total = n / 2;
+    while (total < n) {
+        size_t l = min(dis(gen), n - total);
+        lengths.push_back(l);
+        total += l;
+    }
+    return lengths;
+}
+
+vector<size_t> random_lengths(size_t n, mt19937& gen) {
+    vector<size_t> lengths;
+    uniform_int_distribution<size_t> dis(32, 4096);
+    size_t total = 0;
+    while (total < n) {
+        size_t l = min(dis(gen), n - total);
+        lengths.push_back(l);
+        total += l;
+    }
+    return lengths;
+}
+
+// --- Runner ---
+
+template<typename Policy>
+void run_policy(const string& policy_name, const vector<int>& data, int reps) {
+    // Time on plain ints
+    vector<int> copy;
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        copy = data;
+        auto start = high_resolution_clock::now();
+        segment_sort::block_merge_segment_sort<0, Policy>(copy);
+        auto end = high_resolution_clock::now();
+        best = min(best, duration_cast<duration<double, milli>>(end - start).count());
+        if (r == 0 && !is_sorted(copy.begin(), copy.end())) {
+            cerr << policy_name << " failed!" << endl;
+            exit(1);
+        }
+    }
+
+    // Moves and comparisons on instrumented elements
+    vector<CountedInt> counted(data.begin(), data.end());
+    CountedInt::moves = 0;
+    CountedInt::comparisons = 0;
+    segment_sort::block_merge_segment_sort<0, Policy>(counted);
+    double n = static_cast<double>(data.size());
+
+    cout << "   " << left << setw(10) << policy_name << " | " << right << fixed << setprecision(3)
+         << setw(10) << best << " | "
+         << setw(12) << CountedInt::moves << " | "
+         << setw(8) << setprecision(2) << CountedInt::moves / n << " | "
+         << setw(12) << CountedInt::comparisons << " | "
+         << setw(8) << CountedInt::comparisons / n << endl;
+}
+
+void run_distribution(const string& name, const vector<size_t>& lengths, int reps) {
+    mt19937 gen(42);
+    vector<int> data = build_runs(lengths, gen);
+
+    cout << "\n[" << name << "] " << data.size() << " elements, " << lengths.size() << " runs" << endl;
+    cout << "   " << left << setw(10) << "Policy" << " | " << right
+         << setw(10) << "Time (ms)" << " | "
+         << setw(12) << "Moves" << " | "
+         << setw(8) << "Moves/n" << " | "
+         << setw(12) << "Compares" << " | "
+         << setw(8) << "Cmp/n" << endl;
+    run_policy<segment_sort::BalancedMergePolicy>("Balanced", data, reps);
+    run_policy<segment_sort::TimSortMergePolicy>("TimSort", data, reps);
+    run_policy<segment_sort::PowerSortMergePolicy>("PowerSort", data, reps);
+}
+
+int main(int argc, char* argv[]) {
+    size_t size = 1000000;
+    int reps = 5;
+    if (argc > 1) {
+        try {
+            size = std::stoull(argv[1]);
+        } catch (...) {
+            std::cerr << "Invalid size argument. Using default: " << size << std::endl;
+        }
+    }
+
+    mt19937 gen(12345);
+
+    cout << "\n==========================================================================" << endl;
+    cout << "   Merge Policy Benchmark (" << size << " elements, best of " << reps << ")" << endl;
+    cout << "==========================================================================" << endl;
+
+    run_distribution("Descending staircase", staircase_lengths(size, true), reps);
+    run_distribution("Ascending staircase", staircase_lengths(size, false), reps);
+    run_distribution("Long + tail", long_tail_lengths(size, gen), reps);
+    run_distribution("Random lengths", random_lengths(size, gen), reps);
+
+    cout << "==========================================================================" << endl;
+    return 0;
+}
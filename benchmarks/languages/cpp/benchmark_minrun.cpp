@@ -0,0 +1,256 @@
+/**
+ * Min Run Benchmark - Block Merge Segment Sort
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Measures the TimSort/PowerSort-style min run extension:
+ * 1. Run extension kernels: segment_sort::insertion_sort and
+ *    segment_sort::binary_insertion_sort vs the vendored
+ *    algorithms::insertionsort / algorithms::binary_insertionsort.
+ *    The network column is segment_sort::sort_network<block> (8, 16, 32).
+ * 2. End-to-end: block_merge_segment_sort<MinRun> for several thresholds
+ *    vs gfx::timsort and std::stable_sort.
+ * 3. End-to-end: sorting network pre-pass sizes (MinRun = 32).
+ *
+ * Build: g++ -O2 -std=c++17 benchmark_minrun.cpp -o benchmark_minrun
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <string>
+#include <numeric>
+
+#include "insertionsort.h"
+#include "timsort.h"
+#include "../../../implementations/cpp/block_merge_segment_sort.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// --- Helpers ---
+
+void fill_random(vector<int>& arr) {
+    mt19937 gen(42);
+    uniform_int_distribution<> dis(1, 1000000);
+    for (auto& x : arr) x = dis(gen);
+}
+
+void fill_nearly_sorted(vector<int>& arr) {
+    iota(arr.begin(), arr.end(), 0);
+    size_t n = arr.size();
+    mt19937 gen(42);
+    uniform_int_distribution<size_t> dis(0, n - 1);
+    for (size_t i = 0; i < n / 100; ++i) {
+        swap(arr[dis(gen)], arr[dis(gen)]);
+    }
+}
+
+void fill_short_runs(vector<int>& arr) {
+    // Ascending runs of 2..8 elements: worst case for plain run detection
+    mt19937 gen(42);
+    uniform_int_distribution<> len_dis(2, 8);
+    uniform_int_distribution<> val_dis(1, 1000000);
+    size_t i = 0;
+    while (i < arr.size()) {
+        size_t len = min<size_t>(len_dis(gen), arr.size() - i);
+        for (size_t j = 0; j < len; ++j) arr[i + j] = val_dis(gen);
+        sort(arr.begin() + i, arr.begin() + i + len);
+        i += len;
+    }
+}
+
+bool check_sorted(const vector<int>& arr) {
+    return is_sorted(arr.begin(), arr.end());
+}
+
+template<typename SortFn>
+double time_sort(const vector<int>& original, SortFn sort_fn, int reps) {
+    vector<int> copy(original.size());
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        copy = original;
+        auto start = high_resolution_clock::now();
+        sort_fn(copy);
+        auto end = high_resolution_clock::now();
+        best = min(best, duration_cast<duration<double, milli>>(end - start).count());
+        if (r == 0 && !check_sorted(copy)) {
+            cerr << "Validation failed!" << endl;
+            exit(1);
+        }
+    }
+    return best;
+}
+
+// --- 1. Run extension kernels (sort every block of `block` elements) ---
+
+template<typename Kernel>
+double time_blocks(const vector<int>& data, size_t block, Kernel kernel, int reps) {
+    vector<int> copy;
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        copy = data;
+        auto start = high_resolution_clock::now();
+        for (size_t i = 0; i < copy.size(); i += block) {
+            kernel(copy, i, min(copy.size(), i + block));
+        }
+        auto end = high_resolution_clock::now();
+        best = min(best, duration_cast<duration<double, milli>>(end - start).count());
+        for (size_t i = 0; i < copy.size(); i += block) {
+            if (!is_sorted(copy.begin() + i, copy.begin() + min(copy.size(), i + block))) {
+                cerr << "Kernel validation failed!" << endl;
+                exit(1);
+            }
+        }
+    }
+    return best;
+}
+
+void run_kernel_benchmark(const vector<int>& data, size_t block, int reps) {
+    double t_lin = time_blocks(data, block, [](vector<int>& a, size_t lo, size_t hi) {
+        segment_sort::insertion_sort(a.data(), lo, lo + 1, hi, std::less<int>());
+    }, reps);
+    double t_bin = time_blocks(data, block, [](vector<int>& a, size_t lo, size_t hi) {
+        segment_sort::binary_insertion_sort(a.data(), lo, lo + 1, hi, std::less<int>());
+    }, reps);
+    double t_ins = time_blocks(data, block, [](vector<int>& a, size_t lo, size_t hi) {
+        algorithms::insertionsort(a.begin() + lo, a.begin() + hi);
+    }, reps);
+    double t_bins = time_blocks(data, block, [](vector<int>& a, size_t lo, size_t hi) {
+        algorithms::binary_insertionsort(a.begin() + lo, a.begin() + hi);
+    }, reps);
+    // Networks only sort whole blocks; the tail (size % block) uses insertion
+    auto network = [block](vector<int>& a, size_t lo, size_t hi) {
+        if (hi - lo < block) {
+            segment_sort::insertion_sort(a.data(), lo, lo + 1, hi, std::less<int>());
+        } else if (block == 8) {
+            segment_sort::sort_network<8>(a.data() + lo, std::less<int>());
+        } else if (block == 16) {
+            segment_sort::sort_network<16>(a.data() + lo, std::less<int>());
+        } else {
+            segment_sort::sort_network<32>(a.data() + lo, std::less<int>());
+        }
+    };
+
+    cout << right << setw(6) << block << " | " << fixed << setprecision(3)
+         << setw(10) << t_lin << " | "
+         << setw(10) << t_bin << " | "
+         << setw(13) << t_ins << " | "
+         << setw(19) << t_bins << " | ";
+    if (block <= 32) {
+        cout << setw(8) << time_blocks(data, block, network, reps) << endl;
+    } else {
+        cout << setw(8) << "-" << endl;
+    }
+}
+
+// --- 2. End-to-end ---
+
+void run_end_to_end(const string& name, void (*fill_func)(vector<int>&), size_t n, int reps) {
+    vector<int> data(n);
+    fill_func(data);
+
+    double t0 = time_sort(data, [](vector<int>& a) { segment_sort::block_merge_segment_sort<0>(a); }, reps);
+    double t16 = time_sort(data, [](vector<int>& a) { segment_sort::block_merge_segment_sort<16>(a); }, reps);
+    double t32 = time_sort(data, [](vector<int>& a) { segment_sort::block_merge_segment_sort<32>(a); }, reps);
+    double t64 = time_sort(data, [](vector<int>& a) { segment_sort::block_merge_segment_sort<64>(a); }, reps);
+    double t128 = time_sort(data, [](vector<int>& a) { segment_sort::block_merge_segment_sort<128>(a); }, reps);
+    double ttim = time_sort(data, [](vector<int>& a) { gfx::timsort(a.begin(), a.end()); }, reps);
+    double tstable = time_sort(data, [](vector<int>& a) { stable_sort(a.begin(), a.end()); }, reps);
+
+    cout << left << setw(14) << name << " | " << fixed << setprecision(2) << right
+         << setw(8) << t0 << " | "
+         << setw(8) << t16 << " | "
+         << setw(8) << t32 << " | "
+         << setw(8) << t64 << " | "
+         << setw(8) << t128 << " | "
+         << setw(8) << ttim << " | "
+         << setw(8) << tstable << endl;
+}
+
+// --- 3. Sorting network pre-pass ---
+
+template<size_t NetworkSize>
+void network_sort(vector<int>& a) {
+    segment_sort::block_merge_segment_sort<BLOCK_MERGE_DEFAULT_MIN_RUN, segment_sort::BalancedMergePolicy, NetworkSize>(a);
+}
+
+void run_network_end_to_end(const string& name, void (*fill_func)(vector<int>&), size_t n, int reps) {
+    vector<int> data(n);
+    fill_func(data);
+
+    double t0 = time_sort(data, network_sort<0>, reps);
+    double t8 = time_sort(data, network_sort<8>, reps);
+    double t16 = time_sort(data, network_sort<16>, reps);
+    double t32 = time_sort(data, network_sort<32>, reps);
+
+    cout << left << setw(14) << name << " | " << fixed << setprecision(2) << right
+         << setw(9) << t0 << " | "
+         << setw(8) << t8 << " | "
+         << setw(8) << t16 << " | "
+         << setw(8) << t32 << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t size = 1000000;
+    int reps = 5;
+    if (argc > 1) {
+        try {
+            size = std::stoull(argv[1]);
+        } catch (...) {
+            std::cerr << "Invalid size argument. Using default: " << size << std::endl;
+        }
+    }
+
+    vector<int> random_data(size);
+    fill_random(random_data);
+
+    cout << "\n==================================================================" << endl;
+    cout << "   Run extension kernels (" << size << " random elements, best of " << reps << ", ms)" << endl;
+    cout << "==================================================================" << endl;
+    cout << right << setw(6) << "Block" << " | "
+         << setw(10) << "ss::linear" << " | "
+         << setw(10) << "ss::binary" << " | "
+         << setw(13) << "insertionsort" << " | "
+         << setw(19) << "binary_insertionsort" << " | "
+         << setw(8) << "network" << endl;
+    cout << "-----------------------------------------------------------------------------" << endl;
+    for (size_t block : {8, 16, 32, 64, 128}) {
+        run_kernel_benchmark(random_data, block, reps);
+    }
+
+    cout << "\n==========================================================================================" << endl;
+    cout << "   End-to-end: block_merge_segment_sort<MinRun> vs gfx::timsort (" << size << " elements, ms)" << endl;
+    cout << "==========================================================================================" << endl;
+    cout << left << setw(14) << "Data Type" << " | " << right
+         << setw(8) << "MinRun=0" << " | "
+         << setw(8) << "16" << " | "
+         << setw(8) << "32" << " | "
+         << setw(8) << "64" << " | "
+         << setw(8) << "128" << " | "
+         << setw(8) << "timsort" << " | "
+         << setw(8) << "stable" << endl;
+    cout << "------------------------------------------------------------------------------------------" << endl;
+    run_end_to_end("Random", fill_random, size, reps);
+    run_end_to_end("Short Runs", fill_short_runs, size, reps);
+    run_end_to_end("Nearly Sorted", fill_nearly_sorted, size, reps);
+    cout << "==========================================================================================" << endl;
+
+    cout << "\n==================================================================" << endl;
+    cout << "   Sorting network pre-pass, MinRun = 32 (" << size << " elements, ms)" << endl;
+    cout << "==================================================================" << endl;
+    cout << left << setw(14) << "Data Type" << " | " << right
+         << setw(9) << "Network=0" << " | "
+         << setw(8) << "8" << " | "
+         << setw(8) << "16" << " | "
+         << setw(8) << "32" << endl;
+    cout << "------------------------------------------------------------------" << endl;
+    run_network_end_to_end("Random", fill_random, size, reps);
+    run_network_end_to_end("Short Runs", fill_short_runs, size, reps);
+    run_network_end_to_end("Nearly Sorted", fill_nearly_sorted, size, reps);
+    cout << "==================================================================" << endl;
+    return 0;
+}
@@ -0,0 +1,205 @@
+/**
+ * Sorted Set Operations Benchmark - Block Merge Segment Sort
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Times segment_sort::set_union / set_intersection / set_difference /
+ * merge_unique (set_operations.h) against std::set_union /
+ * std::set_intersection / std::set_difference and std::set_union +
+ * std::unique, on two sorted int32 or int64 inputs of N elements:
+ * - Random 50%: keys drawn from 2N values (about 40% shared)
+ * - Random sparse: keys drawn from 100N values (about 1% shared)
+ * - Sets 50%: each of 2N values is in a with probability 1/2 and in b
+ *   with probability 1/2, so there are no duplicates (the SIMD case)
+ * - Identical: b is a copy of a
+ * - Blocks: alternating stretches of 1000 keys, no overlap
+ * - Skewed 1:1000: a has N / 1000 elements
+ * - Duplicates: keys drawn from N / 10 values
+ *
+ * The SIMD intersection is compiled in only with AVX2
+ * (-DSEGMENT_SORT_ARCH=avx2 or native); the header line says which.
+ *
+ * Build: g++ -O2 -std=c++17 -mavx2 benchmark_set_operations.cpp -o benchmark_set_operations
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <string>
+#include <iterator>
+#include <cstdint>
+
+#include "../../../implementations/cpp/set_operations.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// --- Data ---
+
+template<typename T>
+void fill_range(vector<T>& arr, uint64_t range, unsigned seed) {
+    mt19937_64 gen(seed);
+    for (auto& x : arr) x = static_cast<T>(gen() % range);
+    sort(arr.begin(), arr.end());
+}
+
+template<typename T>
+void make_random_half(vector<T>& a, vector<T>& b, size_t n) {
+    a.resize(n);
+    b.resize(n);
+    fill_range(a, 2 * n, 1);
+    fill_range(b, 2 * n, 2);
+}
+
+template<typename T>
+void make_random_sparse(vector<T>& a, vector<T>& b, size_t n) {
+    a.resize(n);
+    b.resize(n);
+    fill_range(a, 100 * n, 1);
+    fill_range(b, 100 * n, 2);
+}
+
+template<typename T>
+void make_sets_half(vector<T>& a, vector<T>& b, size_t n) {
+    mt19937_64 gen(3);
+    a.clear();
+    b.clear();
+    for (size_t v = 0; v < 2 * n; ++v) {
+        const uint64_t bits = gen();
+        if (bits & 1) a.push_back(static_cast<T>(v));
+        if (bits & 2) b.push_back(static_cast<T>(v));
+    }
+}
+
+template<typename T>
+void make_identical(vector<T>& a, vector<T>& b, size_t n) {
+    a.resize(n);
+    fill_range(a, 2 * n, 1);
+    b = a;
+}
+
+template<typename T>
+void make_blocks(vector<T>& a, vector<T>& b, size_t n) {
+    a.clear();
+    b.clear();
+    for (size_t i = 0; i < 2 * n; ++i) ((i / 1000) % 2 == 0 ? a : b).push_back(static_cast<T>(i));
+}
+
+template<typename T>
+void make_skewed(vector<T>& a, vector<T>& b, size_t n) {
+    a.resize(max<size_t>(1, n / 1000));
+    b.resize(n);
+    fill_range(a, 2 * n, 1);
+    fill_range(b, 2 * n, 2);
+}
+
+template<typename T>
+void make_duplicates(vector<T>& a, vector<T>& b, size_t n) {
+    a.resize(n);
+    b.resize(n);
+    fill_range(a, max<size_t>(1, n / 10), 1);
+    fill_range(b, max<size_t>(1, n / 10), 2);
+}
+
+// --- Timing ---
+
+template<typename T, typename Fn>
+double time_op(const vector<T>& expected, Fn fn, int reps) {
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        auto start = high_resolution_clock::now();
+        vector<T> result = fn();
+        auto end = high_resolution_clock::now();
+        best = min(best, duration_cast<duration<double, milli>>(end - start).count());
+        if (r == 0 && result != expected) {
+            cerr << "Validation failed!" << endl;
+            exit(1);
+        }
+    }
+    return best;
+}
+
+template<typename T>
+void run_case(const string& name, void (*make)(vector<T>&, vector<T>&, size_t), size_t n, int reps) {
+    vector<T> a, b;
+    make(a, b, n);
+
+    // std reference results
+    auto std_union = [&]() {
+        vector<T> out;
+        out.reserve(a.size() + b.size());
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), back_inserter(out));
+        return out;
+    };
+    auto std_intersection = [&]() {
+        vector<T> out;
+        out.reserve(min(a.size(), b.size()));
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), back_inserter(out));
+        return out;
+    };
+    auto std_difference = [&]() {
+        vector<T> out;
+        out.reserve(a.size());
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(), back_inserter(out));
+        return out;
+    };
+    auto std_unique = [&]() {
+        vector<T> out = std_union();
+        out.erase(unique(out.begin(), out.end()), out.end());
+        return out;
+    };
+
+    double t[8];
+    t[0] = time_op(std_union(), [&]() { return segment_sort::set_union(a, b); }, reps);
+    t[1] = time_op(std_union(), std_union, reps);
+    t[2] = time_op(std_intersection(), [&]() { return segment_sort::set_intersection(a, b); }, reps);
+    t[3] = time_op(std_intersection(), std_intersection, reps);
+    t[4] = time_op(std_difference(), [&]() { return segment_sort::set_difference(a, b); }, reps);
+    t[5] = time_op(std_difference(), std_difference, reps);
+    t[6] = time_op(std_unique(), [&]() { return segment_sort::merge_unique(a, b); }, reps);
+    t[7] = time_op(std_unique(), std_unique, reps);
+
+    cout << left << setw(15) << name << " | " << right << fixed << setprecision(2);
+    for (int k = 0; k < 8; ++k) cout << setw(7) << t[k] << (k % 2 ? " | " : " ");
+    cout << endl;
+}
+
+template<typename T>
+void run_type(const string& type_name, size_t n, int reps) {
+    cout << "\n=====================================================================================" << endl;
+    cout << "   " << type_name << ", " << n << " elements per input (best of " << reps << ", ms, segment_sort | std)" << endl;
+    cout << "=====================================================================================" << endl;
+    cout << left << setw(15) << "Data Type" << " | " << right
+         << setw(15) << "union" << " | "
+         << setw(15) << "intersection" << " | "
+         << setw(15) << "difference" << " | "
+         << setw(15) << "merge_unique" << " | " << endl;
+    cout << "-------------------------------------------------------------------------------------" << endl;
+    run_case<T>("Random 50%", make_random_half<T>, n, reps);
+    run_case<T>("Random sparse", make_random_sparse<T>, n, reps);
+    run_case<T>("Sets 50%", make_sets_half<T>, n, reps);
+    run_case<T>("Identical", make_identical<T>, n, reps);
+    run_case<T>("Blocks", make_blocks<T>, n, reps);
+    run_case<T>("Skewed 1:1000", make_skewed<T>, n, reps);
+    run_case<T>("Duplicates", make_duplicates<T>, n, reps);
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = 1000000;
+    int reps = 5;
+    if (argc > 1) {
+        try {
+            n = std::stoull(argv[1]);
+        } catch (...) {
+            std::cerr << "Invalid size argument. Using the default size" << std::endl;
+        }
+    }
+
+    cout << "SIMD intersection: " << (SEGMENT_SORT_SIMD_INTERSECTION ? "AVX2" : "off (scalar build)") << endl;
+    run_type<int32_t>("int32", n, reps);
+    run_type<int64_t>("int64", n, reps);
+    return 0;
+}
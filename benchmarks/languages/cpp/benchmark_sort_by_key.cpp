@@ -0,0 +1,192 @@
+/**
+ * Key-Value Sort Benchmark - Block Merge Segment Sort
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Sorts (timestamp, row-id, payload) rows with a payload of 32-128 bytes:
+ * - AoS: vector<Row> sorted by timestamp with block_merge_segment_sort
+ *   (whole rows move through the merge buffer on every level)
+ * - AoS: std::stable_sort on the same rows (reference)
+ * - SoA: segment_sort::sort_by_key(timestamps, row_ids, payloads)
+ *   (merges move only keys + 32-bit indices, payloads permuted once)
+ *
+ * Build: g++ -O2 -std=c++17 benchmark_sort_by_key.cpp -o benchmark_sort_by_key
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <string>
+#include <cstdint>
+#include <cstring>
+
+#include "../../../implementations/cpp/block_merge_segment_sort.h"
+#include "../../../implementations/cpp/sort_by_key.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// --- Row layouts ---
+
+template<size_t Bytes>
+struct Payload {
+    unsigned char data[Bytes];
+};
+
+template<size_t Bytes>
+struct Row {
+    uint64_t timestamp;
+    uint32_t row_id;
+    Payload<Bytes> payload;
+};
+
+// --- Data ---
+
+vector<uint64_t> make_timestamps(size_t n, bool nearly_sorted) {
+    mt19937_64 gen(42);
+    vector<uint64_t> ts(n);
+    if (nearly_sorted) {
+        // Event log: increasing timestamps with 1% late arrivals
+        uint64_t t = 1700000000000ULL;
+        uniform_int_distribution<uint64_t> step(0, 10);
+        for (auto& x : ts) { t += step(gen); x = t; }
+        uniform_int_distribution<size_t> pos(0, n - 1);
+        for (size_t i = 0; i < n / 100; ++i) swap(ts[pos(gen)], ts[pos(gen)]);
+    } else {
+        uniform_int_distribution<uint64_t> dis(0, n / 4);  // plenty of duplicate keys
+        for (auto& x : ts) x = dis(gen);
+    }
+    return ts;
+}
+
+template<size_t Bytes>
+Payload<Bytes> payload_for(uint32_t id) {
+    Payload<Bytes> p;
+    memset(p.data, static_cast<int>(id & 0xFF), Bytes);
+    memcpy(p.data, &id, sizeof(id));
+    return p;
+}
+
+// Stable by timestamp, and payload still belongs to its row
+template<size_t Bytes>
+bool check_rows(const vector<uint64_t>& ts, const vector<uint32_t>& ids, const vector<Payload<Bytes>>& payloads) {
+    for (size_t i = 0; i < ts.size(); ++i) {
+        uint32_t tag;
+        memcpy(&tag, payloads[i].data, sizeof(tag));
+        if (tag != ids[i]) return false;
+        if (i > 0 && (ts[i - 1] > ts[i] || (ts[i - 1] == ts[i] && ids[i - 1] > ids[i]))) return false;
+    }
+    return true;
+}
+
+template<size_t Bytes>
+bool check_aos(const vector<Row<Bytes>>& rows) {
+    vector<uint64_t> ts(rows.size());
+    vector<uint32_t> ids(rows.size());
+    vector<Payload<Bytes>> payloads(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        ts[i] = rows[i].timestamp;
+        ids[i] = rows[i].row_id;
+        payloads[i] = rows[i].payload;
+    }
+    return check_rows(ts, ids, payloads);
+}
+
+template<typename Fn>
+double best_of(int reps, Fn fn) {
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        best = min(best, fn());
+    }
+    return best;
+}
+
+// --- Runner ---
+
+template<size_t Bytes>
+void run_payload(const string& data_name, const vector<uint64_t>& ts, int reps) {
+    size_t n = ts.size();
+
+    vector<uint32_t> ids(n);
+    vector<Payload<Bytes>> payloads(n);
+    vector<Row<Bytes>> rows(n);
+    for (size_t i = 0; i < n; ++i) {
+        ids[i] = static_cast<uint32_t>(i);
+        payloads[i] = payload_for<Bytes>(ids[i]);
+        rows[i] = {ts[i], ids[i], payloads[i]};
+    }
+
+    auto by_timestamp = [](const Row<Bytes>& a, const Row<Bytes>& b) { return a.timestamp < b.timestamp; };
+
+    double t_aos = best_of(reps, [&]() {
+        vector<Row<Bytes>> copy = rows;
+        auto start = high_resolution_clock::now();
+        segment_sort::block_merge_segment_sort(copy.data(), n, BLOCK_MERGE_DEFAULT_BUFFER_SIZE, by_timestamp);
+        auto end = high_resolution_clock::now();
+        if (!check_aos(copy)) { cerr << "AoS block merge failed!" << endl; exit(1); }
+        return duration_cast<duration<double, milli>>(end - start).count();
+    });
+
+    double t_stable = best_of(reps, [&]() {
+        vector<Row<Bytes>> copy = rows;
+        auto start = high_resolution_clock::now();
+        stable_sort(copy.begin(), copy.end(), by_timestamp);
+        auto end = high_resolution_clock::now();
+        if (!check_aos(copy)) { cerr << "AoS stable_sort failed!" << endl; exit(1); }
+        return duration_cast<duration<double, milli>>(end - start).count();
+    });
+
+    double t_soa = best_of(reps, [&]() {
+        vector<uint64_t> k = ts;
+        vector<uint32_t> v1 = ids;
+        vector<Payload<Bytes>> v2 = payloads;
+        auto start = high_resolution_clock::now();
+        segment_sort::sort_by_key(k, v1, v2);
+        auto end = high_resolution_clock::now();
+        if (!check_rows(k, v1, v2)) { cerr << "sort_by_key failed!" << endl; exit(1); }
+        return duration_cast<duration<double, milli>>(end - start).count();
+    });
+
+    cout << left << setw(14) << data_name << " | " << right << setw(7) << sizeof(Row<Bytes>) << " | "
+         << fixed << setprecision(2)
+         << setw(12) << t_aos << " | "
+         << setw(12) << t_stable << " | "
+         << setw(12) << t_soa << " | "
+         << setw(7) << t_aos / t_soa << "x" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t size = 1000000;
+    int reps = 3;
+    if (argc > 1) {
+        try {
+            size = std::stoull(argv[1]);
+        } catch (...) {
+            std::cerr << "Invalid size argument. Using default: " << size << std::endl;
+        }
+    }
+
+    cout << "\n==========================================================================" << endl;
+    cout << "   Key-Value Sort Benchmark (" << size << " rows, best of " << reps << ", ms)" << endl;
+    cout << "==========================================================================" << endl;
+    cout << left << setw(14) << "Data Type" << " | " << right
+         << setw(7) << "Row B" << " | "
+         << setw(12) << "AoS block" << " | "
+         << setw(12) << "AoS stable" << " | "
+         << setw(12) << "sort_by_key" << " | "
+         << setw(8) << "Speedup" << endl;
+    cout << "--------------------------------------------------------------------------" << endl;
+
+    for (bool nearly : {false, true}) {
+        vector<uint64_t> ts = make_timestamps(size, nearly);
+        string name = nearly ? "Nearly Sorted" : "Random";
+        run_payload<32>(name, ts, reps);
+        run_payload<64>(name, ts, reps);
+        run_payload<128>(name, ts, reps);
+    }
+    cout << "==========================================================================" << endl;
+    return 0;
+}
@@ -0,0 +1,165 @@
+/**
+ * Stability Benchmark - Segment Sort C++ Entry Points
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Sorts tagged records (key, original index) by key only, the shape of a
+ * multi-key sort pass, and reports time together with a stability check for:
+ * - block_merge_segment_sort (comparator overload)
+ * - segment_sort::sort_by_key (keys + tag array)
+ * - segment_sort::argsort + gather
+ * - SegmentSort::Iterator (full drain)
+ * - std::stable_sort (reference)
+ *
+ * Build: g++ -O2 -std=c++17 benchmark_stability.cpp -o benchmark_stability
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <string>
+#include <sstream>
+#include <cstdint>
+
+#include "../../../implementations/cpp/block_merge_segment_sort.h"
+#include "../../../implementations/cpp/sort_by_key.h"
+#include "../../../implementations/cpp/argsort.h"
+#include "../../../implementations/cpp/SegmentSortIterator.h"
+
+using namespace std;
+using namespace std::chrono;
+
+struct Record {
+    int key;
+    int index;
+};
+
+bool by_key(const Record& a, const Record& b) {
+    return a.key < b.key;
+}
+
+// --- Key distributions (all heavy in duplicates) ---
+
+void fill_few_unique(vector<int>& keys) {
+    mt19937 gen(42);
+    uniform_int_distribution<> dis(0, 9);
+    for (auto& k : keys) k = dis(gen);
+}
+
+void fill_many_duplicates(vector<int>& keys) {
+    mt19937 gen(42);
+    uniform_int_distribution<> dis(0, static_cast<int>(keys.size() / 100));
+    for (auto& k : keys) k = dis(gen);
+}
+
+void fill_sorted_duplicates(vector<int>& keys) {
+    for (size_t i = 0; i < keys.size(); ++i) keys[i] = static_cast<int>(i / 8);
+}
+
+void fill_reverse_duplicates(vector<int>& keys) {
+    for (size_t i = 0; i < keys.size(); ++i) keys[i] = static_cast<int>((keys.size() - i) / 8);
+}
+
+bool is_stable_sorted(const vector<Record>& arr) {
+    for (size_t i = 1; i < arr.size(); ++i) {
+        if (arr[i - 1].key > arr[i].key) return false;
+        if (arr[i - 1].key == arr[i].key && arr[i - 1].index > arr[i].index) return false;
+    }
+    return true;
+}
+
+// --- Runner ---
+
+template<typename SortFn>
+string time_stable(const vector<Record>& original, SortFn sort_fn, int reps) {
+    double best = 1e300;
+    bool stable = true;
+    for (int r = 0; r < reps; ++r) {
+        vector<Record> out;
+        auto start = high_resolution_clock::now();
+        sort_fn(original, out);
+        auto end = high_resolution_clock::now();
+        best = min(best, duration_cast<duration<double, milli>>(end - start).count());
+        if (r == 0) stable = is_stable_sorted(out) && out.size() == original.size();
+    }
+    ostringstream cell;
+    cell << fixed << setprecision(2) << best << (stable ? "  " : " !");
+    return cell.str();
+}
+
+void run_test(const string& name, void (*fill_func)(vector<int>&), size_t n, int reps) {
+    vector<int> keys(n);
+    fill_func(keys);
+    vector<Record> records(n);
+    for (size_t i = 0; i < n; ++i) records[i] = {keys[i], static_cast<int>(i)};
+
+    string t_block = time_stable(records, [](const vector<Record>& in, vector<Record>& out) {
+        out = in;
+        segment_sort::block_merge_segment_sort(out.data(), out.size(), BLOCK_MERGE_DEFAULT_BUFFER_SIZE, by_key);
+    }, reps);
+
+    string t_by_key = time_stable(records, [](const vector<Record>& in, vector<Record>& out) {
+        vector<int> k(in.size()), idx(in.size());
+        for (size_t i = 0; i < in.size(); ++i) { k[i] = in[i].key; idx[i] = in[i].index; }
+        segment_sort::sort_by_key(k, idx);
+        out.resize(in.size());
+        for (size_t i = 0; i < in.size(); ++i) out[i] = {k[i], idx[i]};
+    }, reps);
+
+    string t_argsort = time_stable(records, [](const vector<Record>& in, vector<Record>& out) {
+        vector<uint32_t> perm(in.size());
+        segment_sort::argsort(in.data(), in.size(), perm.data(), by_key);
+        out.resize(in.size());
+        for (size_t i = 0; i < in.size(); ++i) out[i] = in[perm[i]];
+    }, reps);
+
+    string t_iter = time_stable(records, [](const vector<Record>& in, vector<Record>& out) {
+        SegmentSort::Iterator<Record, bool (*)(const Record&, const Record&)> iter(in, by_key);
+        out.reserve(in.size());
+        while (iter.hasNext()) out.push_back(iter.next());
+    }, reps);
+
+    string t_std = time_stable(records, [](const vector<Record>& in, vector<Record>& out) {
+        out = in;
+        stable_sort(out.begin(), out.end(), by_key);
+    }, reps);
+
+    cout << left << setw(16) << name << " | " << right
+         << setw(11) << t_block << " | "
+         << setw(11) << t_by_key << " | "
+         << setw(11) << t_argsort << " | "
+         << setw(11) << t_iter << " | "
+         << setw(11) << t_std << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t size = 1000000;
+    int reps = 3;
+    if (argc > 1) {
+        try {
+            size = std::stoull(argv[1]);
+        } catch (...) {
+            std::cerr << "Invalid size argument. Using default: " << size << std::endl;
+        }
+    }
+
+    cout << "\n================================================================================" << endl;
+    cout << "   Stability Benchmark (" << size << " tagged records, best of " << reps << ", ms; '!' = unstable)" << endl;
+    cout << "================================================================================" << endl;
+    cout << left << setw(16) << "Data Type" << " | " << right
+         << setw(11) << "Block Merge" << " | "
+         << setw(11) << "sort_by_key" << " | "
+         << setw(11) << "argsort" << " | "
+         << setw(11) << "Iterator" << " | "
+         << setw(11) << "std::stable" << endl;
+    cout << "--------------------------------------------------------------------------------" << endl;
+    run_test("Few Unique", fill_few_unique, size, reps);
+    run_test("Many Duplicates", fill_many_duplicates, size, reps);
+    run_test("Sorted Dups", fill_sorted_duplicates, size, reps);
+    run_test("Reverse Dups", fill_reverse_duplicates, size, reps);
+    cout << "================================================================================" << endl;
+    return 0;
+}
@@ -21,11 +21,21 @@
 #include <queue>
 #include <map>
 #include <unordered_map>
+#include <type_traits>
 
 // Import Segment Sort implementation
 #include "cpp_benchmarks.h"
+#include "perf_counters.h"
+#include "alloc_tracker.h"
+#include "regression.h"
+#include "element_types.h"
 #include "../../../implementations/cpp/block_merge_segment_sort.h"
 
+// Vendored state-of-the-art competitors
+#include "../../../implementations/cpp/pdqsort.h"
+#include "timsort.h"
+#include "powersort.h"
+
 // On-the-Fly Balanced Merge Sort Implementation
 /**
  * Merges two sorted vectors into a single sorted vector
@@ -222,18 +232,21 @@ std::vector<int>& onTheFlyBalancedMergeSort(std::vector<int>& arr) {
     return arr;
 }
 
-// Global RNG for deterministic results
+// Global RNG for deterministic results; same constants (m = 2^31) as
+// generators.c and generate_datasets.py, so a seed yields the same arrays
 class LCG {
 private:
+    uint64_t initial_seed;
     uint64_t current_seed;
     const uint64_t a = 1103515245;
     const uint64_t c = 12345;
-    const uint64_t m = 2ULL << 31;
+    const uint64_t m = 1ULL << 31;
 
 public:
-    LCG(uint64_t seed = 12345) : current_seed(seed) {}
+    LCG(uint64_t seed = 12345) : initial_seed(seed), current_seed(seed) {}
     
     void setSeed(uint64_t seed) {
+        initial_seed = seed;
         current_seed = seed;
     }
     
@@ -242,13 +255,15 @@ public:
         return static_cast<double>(current_seed) / static_cast<double>(m);
     }
     
-    uint32_t getSeed() const { return current_seed; }
+    // The seed given to setSeed(), so a results file can be regenerated
+    uint64_t getSeed() const { return initial_seed; }
 };
 
 static LCG rng;
 
-// Validation function
-bool isSorted(const std::vector<int>& arr) {
+// Validation function (operator<, as every sorter in the tables uses)
+template<typename T>
+bool isSorted(const std::vector<T>& arr) {
     if (arr.empty()) return true;
     for (size_t i = 1; i < arr.size(); ++i) {
         if (arr[i] < arr[i - 1]) {
@@ -274,10 +289,15 @@ struct BenchmarkResult {
     std::string algorithm;
     size_t size;
     std::string dataType;
+    std::string elementType = "int32";         // Type matrix (--types) only changes these two
+    size_t elementBytes = sizeof(int);
     int repetitions;
     std::vector<double> times;
     Statistics statistics;
-    std::vector<int> sorted_result;
+    std::vector<perf::CounterValues> counters; // One entry per run (empty without --perf)
+    alloc::MemoryUsage memory;                 // One extra, untimed run
+    bool has_sort_stats = false;               // Only in -DSEGMENT_SORT_STATS builds
+    segment_sort::SortStats sort_stats;
     bool success;
     std::string error;
 };
@@ -287,7 +307,8 @@ struct BenchmarkResult {
 
 // Forward declarations for benchmark functions
 std::vector<int> mergeVectors(const std::vector<int>& left, const std::vector<int>& right);
-void exportResults(const std::vector<BenchmarkResult>& results, const std::vector<size_t>& sizes, int repetitions);
+void exportResults(const std::vector<BenchmarkResult>& results, const std::vector<size_t>& sizes, int repetitions,
+                   const std::string& datasetsDir = "", const std::string& filename = "results.json");
 
 // Data generators with deterministic randomness
 std::vector<int> generateRandomArray(size_t size, int min_val = 0, int max_val = 1000) {
@@ -420,6 +441,107 @@ std::vector<int> generateReverseArray(size_t size, int min_val = 0, int max_val
     return arr;
 }
 
+// --- Production-like distributions ---
+// Mirror generators.c call for call (same LCG draws, same double arithmetic)
+
+// N producers with skewed clocks appending non-decreasing timestamps to one
+// log; each element comes from a random producer
+std::vector<int> generateInterleavedStreamsArray(size_t size, size_t num_streams, int min_val = 0, int max_val = 1000000) {
+    std::vector<int> arr;
+    arr.reserve(size);
+    if (num_streams == 0) num_streams = 1;
+    double gap = static_cast<double>(max_val - min_val) * num_streams / size;
+
+    std::vector<double> clocks(num_streams);
+    for (size_t s = 0; s < num_streams; ++s) {
+        clocks[s] = min_val + rng.random() * (max_val - min_val) / 100; // Up to 1% clock skew
+    }
+    for (size_t i = 0; i < size; ++i) {
+        size_t s = static_cast<size_t>(rng.random() * num_streams);
+        clocks[s] += rng.random() * 2 * gap;
+        arr.push_back(static_cast<int>(clocks[s]));
+    }
+    return arr;
+}
+
+// num_teeth ascending ramps from min_val to max_val
+std::vector<int> generateSawtoothArray(size_t size, size_t num_teeth, int min_val = 0, int max_val = 1000000) {
+    std::vector<int> arr;
+    arr.reserve(size);
+    if (num_teeth == 0) num_teeth = 1;
+    size_t tooth = (size + num_teeth - 1) / num_teeth;
+    for (size_t i = 0; i < size; ++i) {
+        arr.push_back(min_val + static_cast<int>(static_cast<double>(max_val - min_val) * (i % tooth) / tooth));
+    }
+    return arr;
+}
+
+// Ascending to the middle, then the mirror image descending
+std::vector<int> generateOrganPipeArray(size_t size, int min_val = 0, int max_val = 1000000) {
+    std::vector<int> arr;
+    arr.reserve(size);
+    size_t half = (size + 1) / 2;
+    for (size_t i = 0; i < size; ++i) {
+        size_t d = std::min(i, size - 1 - i);
+        arr.push_back(min_val + static_cast<int>(static_cast<double>(max_val - min_val) * d / half));
+    }
+    return arr;
+}
+
+// Zipf (s = 1) over num_keys keys, ranks scattered over [min_val, max_val)
+// by a multiplicative hash so the hot keys are not simply the smallest values
+std::vector<int> generateZipfArray(size_t size, size_t num_keys, int min_val = 0, int max_val = 1000000) {
+    std::vector<int> arr;
+    arr.reserve(size);
+    if (num_keys == 0) num_keys = 1;
+
+    std::vector<double> cdf(num_keys);
+    double total = 0.0;
+    for (size_t k = 0; k < num_keys; ++k) {
+        total += 1.0 / static_cast<double>(k + 1);
+        cdf[k] = total;
+    }
+    for (auto& c : cdf) c /= total;
+
+    for (size_t i = 0; i < size; ++i) {
+        double u = rng.random();
+        size_t rank = std::min(static_cast<size_t>(std::upper_bound(cdf.begin(), cdf.end(), u) - cdf.begin()), num_keys - 1);
+        uint64_t key = (static_cast<uint64_t>(rank) * 2654435761ULL) % num_keys;
+        arr.push_back(min_val + static_cast<int>(static_cast<double>(max_val - min_val) * key / num_keys));
+    }
+    return arr;
+}
+
+// Sorted prefix followed by tail_size random appends
+std::vector<int> generateSortedRandomTailArray(size_t size, size_t tail_size, int min_val = 0, int max_val = 1000000) {
+    tail_size = std::min(tail_size, size);
+    std::vector<int> arr = generateSortedArray(size - tail_size, min_val, max_val);
+    arr.reserve(size);
+    for (size_t i = size - tail_size; i < size; ++i) {
+        arr.push_back(static_cast<int>(rng.random() * (max_val - min_val + 1)) + min_val);
+    }
+    return arr;
+}
+
+// Jittered counter climbing from ~min_val to ~max_val that restarts every
+// `period` elements (sequence numbers with rollovers, per-day logs concatenated)
+std::vector<int> generatePeriodicResetsArray(size_t size, size_t period, int min_val = 0, int max_val = 1000000) {
+    std::vector<int> arr;
+    arr.reserve(size);
+    if (period == 0) period = 1;
+    double step = static_cast<double>(max_val - min_val) / period;
+    double value = min_val;
+    for (size_t i = 0; i < size; ++i) {
+        if (i % period == 0) {
+            value = min_val + rng.random() * (max_val - min_val) / 100;
+        } else {
+            value += rng.random() * 2 * step;
+        }
+        arr.push_back(static_cast<int>(value));
+    }
+    return arr;
+}
+
 // Sorting algorithms implementations
 
 std::vector<int> mergeSort(const std::vector<int>& arr) {
@@ -480,37 +602,31 @@ void heapify(std::vector<int>& arr, size_t n, size_t i) {
     }
 }
 
-std::vector<int> heapSort(const std::vector<int>& arr) {
-    std::vector<int> copy = arr;
-    size_t n = copy.size();
+void heapSort(std::vector<int>& arr) {
+    size_t n = arr.size();
 
     // Build heap
     for (int i = static_cast<int>(n / 2) - 1; i >= 0; --i)
-        heapify(copy, n, static_cast<size_t>(i));
+        heapify(arr, n, static_cast<size_t>(i));
 
     // Extract elements
     for (int i = static_cast<int>(n) - 1; i > 0; --i) {
-        std::swap(copy[0], copy[i]);
-        heapify(copy, static_cast<size_t>(i), 0);
+        std::swap(arr[0], arr[i]);
+        heapify(arr, static_cast<size_t>(i), 0);
     }
-
-    return copy;
 }
 
-std::vector<int> builtinSort(const std::vector<int>& arr) {
-    std::vector<int> copy = arr;
-    std::sort(copy.begin(), copy.end());
-    return copy;
+void builtinSort(std::vector<int>& arr) {
+    std::sort(arr.begin(), arr.end());
 }
 
-std::vector<int> stableSort(const std::vector<int>& arr) {
-    std::vector<int> copy = arr;
-    std::stable_sort(copy.begin(), copy.end());
-    return copy;
+void stableSort(std::vector<int>& arr) {
+    std::stable_sort(arr.begin(), arr.end());
 }
 
 // Original SegmentSort implementation using priority queue for k-way merge
-std::vector<int> segmentSortOriginal(const std::vector<int>& arr) {
+// (copyarr is the algorithm's own auxiliary array; output goes back to arr)
+void segmentSortOriginal(std::vector<int>& arr) {
     int n = arr.size();
     std::vector<int> copyarr = arr;
 
@@ -567,14 +683,13 @@ std::vector<int> segmentSortOriginal(const std::vector<int>& arr) {
     }
 
     // Extract minimum elements using k-way merge
-    std::vector<int> result;
-    result.reserve(n);
+    size_t out = 0;
 
     while (!minHeap.empty()) {
         Segment current = minHeap.top();
         minHeap.pop();
 
-        result.push_back(copyarr[current.start]);
+        arr[out++] = copyarr[current.start];
 
         // If the segment still has elements, push it back to the heap
         if (current.length > 0) {       // Positive segment (increasing)
@@ -589,8 +704,6 @@ std::vector<int> segmentSortOriginal(const std::vector<int>& arr) {
             }
         }
     }
-
-    return result;
 }
 
 
@@ -632,36 +745,67 @@ Statistics calculateStats(const std::vector<double>& times) {
 }
 
 
-void warmUp(const std::function<std::vector<int>(const std::vector<int>&)>& algorithm, 
-           const std::vector<int>& array, int warmup_runs = 3) {
+// In-place sorter: sorts the vector it is given. Function pointers keep the
+// call out of std::function and let runBenchmark stay a template.
+using SortFunc = void (*)(std::vector<int>&);
+
+// Same sort, reporting internal counters (block merge variants only)
+using StatsFunc = void (*)(std::vector<int>&, segment_sort::SortStats*);
+
+// Restores the pristine input into the pre-allocated work buffer (outside the clock)
+template<typename T>
+inline void resetInput(std::vector<T>& work, const std::vector<T>& array) {
+    if (array.empty()) return;
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        std::memcpy(work.data(), array.data(), array.size() * sizeof(T));
+    } else {
+        std::copy(array.begin(), array.end(), work.begin()); // Reuses the strings' capacity
+    }
+}
+
+template<typename SortFn, typename T>
+void warmUp(SortFn&& algorithm, std::vector<T>& work, const std::vector<T>& array, int warmup_runs = 3) {
     try {
         for (int i = 0; i < warmup_runs; ++i) {
-            algorithm(array);
+            resetInput(work, array);
+            algorithm(work);
         }
     } catch (...) {
         // Silently ignore warm-up errors
     }
 }
 
-BenchmarkResult runBenchmark(const std::function<std::vector<int>(const std::vector<int>&)>& algorithm,
-                            const std::vector<int>& array, const std::string& name, const std::string& dataType, int repetitions = 10, bool validate_results = true) {
+// Only the sort call is timed: the input is copied into a buffer allocated
+// once per benchmark, and the result is validated in place after the clock stops.
+// Hardware counters (if given and available) wrap the timed region: they are
+// started before and read after the clock so their syscalls are not timed.
+template<typename SortFn, typename T>
+BenchmarkResult runBenchmark(SortFn&& algorithm, const std::vector<T>& array, const std::string& name,
+                             const std::string& dataType, int repetitions = 10, bool validate_results = true,
+                             perf::CounterGroup* counters = nullptr) {
     std::vector<double> times;
-    std::vector<int> sorted_result;
+    std::vector<perf::CounterValues> counter_runs;
+    times.reserve(repetitions);
+    std::vector<T> work(array);
     bool success = true;
     std::string error;
     
     // Warm-up run
-    warmUp(algorithm, array);
+    warmUp(algorithm, work, array);
     
     // Multiple runs for statistical analysis
     for (int rep = 0; rep < repetitions; ++rep) {
         try {
+            resetInput(work, array);
+
+            if (counters) counters->start();
             auto start = std::chrono::high_resolution_clock::now();
-            std::vector<int> result = algorithm(array);
+            algorithm(work);
             auto end = std::chrono::high_resolution_clock::now();
+            if (counters) counter_runs.push_back(counters->stop());
 
             // Validate that result is correctly sorted (if validation is enabled)
-            if (validate_results && !isSorted(result)) {
+            if (validate_results && (work.size() != array.size() || !isSorted(work))) {
                 success = false;
                 error = "Validation failed: Array is not properly sorted";
                 break;
@@ -669,10 +813,6 @@ BenchmarkResult runBenchmark(const std::function<std::vector<int>(const std::vec
 
             auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
             times.push_back(duration.count() / 1e6); // Convert to milliseconds
-
-            if (rep == 0) {
-                sorted_result = result;
-            }
         } catch (const std::exception& err) {
             success = false;
             error = err.what();
@@ -688,14 +828,21 @@ BenchmarkResult runBenchmark(const std::function<std::vector<int>(const std::vec
     result.algorithm = name;
     result.size = array.size();
     result.dataType = dataType;
+    result.elementBytes = sizeof(T);
     result.repetitions = repetitions;
     result.times = times;
-    result.sorted_result = sorted_result;
+    result.counters = counter_runs;
     result.success = success;
     result.error = error;
     
     if (success) {
         result.statistics = calculateStats(times);
+
+        // Memory: one more run outside the clock; `work` is already allocated
+        resetInput(work, array);
+        alloc::begin();
+        algorithm(work);
+        result.memory = alloc::end();
     }
     
     return result;
@@ -704,91 +851,102 @@ BenchmarkResult runBenchmark(const std::function<std::vector<int>(const std::vec
 // Sorters dictionary
 struct Sorter {
     std::string name;
-    std::function<std::vector<int>(const std::vector<int>&)> func;
+    SortFunc func;
+    StatsFunc stats_func = nullptr;
 };
 
+// One extra, untimed run that fills result.sort_stats. Instrumented builds
+// are slower, so the counters never come from the timed repetitions.
+void collectSortStats(StatsFunc stats_func, const std::vector<int>& array, BenchmarkResult& result) {
+    if (!segment_sort::SORT_STATS_ENABLED || !stats_func || !result.success) return;
+    std::vector<int> work(array);
+    stats_func(work, &result.sort_stats);
+    result.has_sort_stats = true;
+}
+
+void balancedSegmentMergeSort(std::vector<int>& arr) {
+    onTheFlyBalancedMergeSort(arr);
+}
+
+template<size_t BufferSize>
+void blockMergeSegmentSort(std::vector<int>& arr) {
+    segment_sort::block_merge_segment_sort(arr, BufferSize);
+}
+
+template<size_t BufferSize>
+void blockMergeSegmentSortStats(std::vector<int>& arr, segment_sort::SortStats* stats) {
+    segment_sort::block_merge_segment_sort(arr, BufferSize, stats);
+}
+
+// Block merge with a ScratchPolicy for its buffer (--scratch)
+template<size_t BufferSize, segment_sort::ScratchPolicy Policy>
+void blockMergeSegmentSortScratch(std::vector<int>& arr) {
+    segment_sort::block_merge_segment_sort(arr.data(), arr.size(), BufferSize, std::less<int>(), nullptr, Policy);
+}
+
+// Top-down merge sort allocates its own halves; that cost is part of the algorithm
+void mergeSortInto(std::vector<int>& arr) {
+    arr = mergeSort(arr);
+}
+
+// Pattern-defeating quicksort (unstable; branchless partitioning for int)
+void pdqSort(std::vector<int>& arr) {
+    pdqsort(arr.begin(), arr.end());
+}
+
+// TimSort (gfx::timsort, stable)
+void timSort(std::vector<int>& arr) {
+    gfx::timsort(arr.begin(), arr.end());
+}
+
+// Powersort (Munro & Wild 2018, stable); allocates its n-element buffer per call
+void powerSort(std::vector<int>& arr) {
+    algorithms::powersort<std::vector<int>::iterator> sorter;
+    sorter.sort(arr.begin(), arr.end());
+}
+
+// --scratch: n/2 buffer (GROW) so that it is large enough to be mapped with
+// each policy; buffers under 2MB ignore the policy
+std::vector<Sorter> getScratchSorters() {
+    using namespace segment_sort;
+    return {
+        {"blockMerge GROW default", blockMergeSegmentSortScratch<BLOCK_MERGE_AUTO_GROW_BUFFER_SIZE, SCRATCH_DEFAULT>},
+        {"blockMerge GROW huge", blockMergeSegmentSortScratch<BLOCK_MERGE_AUTO_GROW_BUFFER_SIZE, SCRATCH_HUGE_PAGES>},
+        {"blockMerge GROW numa", blockMergeSegmentSortScratch<BLOCK_MERGE_AUTO_GROW_BUFFER_SIZE, SCRATCH_NUMA_LOCAL>},
+        {"blockMerge GROW numa+huge", blockMergeSegmentSortScratch<BLOCK_MERGE_AUTO_GROW_BUFFER_SIZE,
+                                                                   SCRATCH_HUGE_PAGES | SCRATCH_NUMA_LOCAL>},
+        {"std::stable_sort", stableSort}
+    };
+}
+
 std::vector<Sorter> getSorters() {
     return {
-        {"balancedSegmentMergeSort", [](const std::vector<int>& arr) {
-            std::vector<int> copy = arr;
-            return onTheFlyBalancedMergeSort(copy);
-        }},
-        {"blockMergeSegmentSort DEF", [](const std::vector<int>& arr) {
-            std::vector<int> copy = arr;
-            segment_sort::block_merge_segment_sort(copy);
-            return copy;
-        }},
-        {"blockMergeSegmentSort_512", [](const std::vector<int>& arr) {
-            std::vector<int> copy = arr;
-            segment_sort::block_merge_segment_sort(copy, 512);
-            return copy;
-        }},
-        {"blockMergeSegmentSort_1k", [](const std::vector<int>& arr) {
-            std::vector<int> copy = arr;
-            segment_sort::block_merge_segment_sort(copy, 1024);
-            return copy;
-        }},
-        {"blockMergeSegmentSort_2k", [](const std::vector<int>& arr) {
-            std::vector<int> copy = arr;
-            segment_sort::block_merge_segment_sort(copy, 2048);
-            return copy;
-        }},
-        {"blockMergeSegmentSort_4k", [](const std::vector<int>& arr) {
-            std::vector<int> copy = arr;
-            segment_sort::block_merge_segment_sort(copy, 4096);
-            return copy;
-        }},
-        {"blockMergeSegmentSort_8k", [](const std::vector<int>& arr) {
-            std::vector<int> copy = arr;
-            segment_sort::block_merge_segment_sort(copy, 8192);
-            return copy;
-        }},
-        {"blockMergeSegmentSort_16k", [](const std::vector<int>& arr) {
-            std::vector<int> copy = arr;
-            segment_sort::block_merge_segment_sort(copy, 16384);
-            return copy;
-        }},
-        {"blockMergeSegmentSort_32k", [](const std::vector<int>& arr) {
-            std::vector<int> copy = arr;
-            segment_sort::block_merge_segment_sort(copy, 32768);
-            return copy;
-        }},
-        {"blockMergeSegmentSort_64k", [](const std::vector<int>& arr) {
-            std::vector<int> copy = arr;
-            segment_sort::block_merge_segment_sort(copy, 65536);
-            return copy;
-        }},
-        {"blockMergeSegmentSort_128k", [](const std::vector<int>& arr) {
-            std::vector<int> copy = arr;
-            segment_sort::block_merge_segment_sort(copy, 131072);
-            return copy;
-        }},        
-         {"blockMergeSegmentSort_256k", [](const std::vector<int>& arr) {
-            std::vector<int> copy = arr;
-            segment_sort::block_merge_segment_sort(copy, 262144);
-            return copy;
-        }},        
-         {"blockMergeSegmentSort_512k", [](const std::vector<int>& arr) {
-            std::vector<int> copy = arr;
-            segment_sort::block_merge_segment_sort(copy, 524288);
-            return copy;
-        }},        
-         {"blockMergeSegmentSort_1M", [](const std::vector<int>& arr) {
-            std::vector<int> copy = arr;
-            segment_sort::block_merge_segment_sort(copy, 1048576);
-            return copy;
-        }},             
-         {"blockMergeSegmentSort_2M", [](const std::vector<int>& arr) {
-            std::vector<int> copy = arr;
-            segment_sort::block_merge_segment_sort(copy, 2097152);
-            return copy;
-        }},             
+        {"balancedSegmentMergeSort", balancedSegmentMergeSort},
+        {"blockMergeSegmentSort DEF", blockMergeSegmentSort<BLOCK_MERGE_DEFAULT_BUFFER_SIZE>, blockMergeSegmentSortStats<BLOCK_MERGE_DEFAULT_BUFFER_SIZE>},
+        {"blockMergeSegmentSort AUTO", blockMergeSegmentSort<BLOCK_MERGE_AUTO_BUFFER_SIZE>, blockMergeSegmentSortStats<BLOCK_MERGE_AUTO_BUFFER_SIZE>},
+        {"blockMergeSegmentSort GROW", blockMergeSegmentSort<BLOCK_MERGE_AUTO_GROW_BUFFER_SIZE>, blockMergeSegmentSortStats<BLOCK_MERGE_AUTO_GROW_BUFFER_SIZE>},
+        {"blockMergeSegmentSort_512", blockMergeSegmentSort<512>, blockMergeSegmentSortStats<512>},
+        {"blockMergeSegmentSort_1k", blockMergeSegmentSort<1024>, blockMergeSegmentSortStats<1024>},
+        {"blockMergeSegmentSort_2k", blockMergeSegmentSort<2048>, blockMergeSegmentSortStats<2048>},
+        {"blockMergeSegmentSort_4k", blockMergeSegmentSort<4096>, blockMergeSegmentSortStats<4096>},
+        {"blockMergeSegmentSort_8k", blockMergeSegmentSort<8192>, blockMergeSegmentSortStats<8192>},
+        {"blockMergeSegmentSort_16k", blockMergeSegmentSort<16384>, blockMergeSegmentSortStats<16384>},
+        {"blockMergeSegmentSort_32k", blockMergeSegmentSort<32768>, blockMergeSegmentSortStats<32768>},
+        {"blockMergeSegmentSort_64k", blockMergeSegmentSort<65536>, blockMergeSegmentSortStats<65536>},
+        {"blockMergeSegmentSort_128k", blockMergeSegmentSort<131072>, blockMergeSegmentSortStats<131072>},
+        {"blockMergeSegmentSort_256k", blockMergeSegmentSort<262144>, blockMergeSegmentSortStats<262144>},
+        {"blockMergeSegmentSort_512k", blockMergeSegmentSort<524288>, blockMergeSegmentSortStats<524288>},
+        {"blockMergeSegmentSort_1M", blockMergeSegmentSort<1048576>, blockMergeSegmentSortStats<1048576>},
+        {"blockMergeSegmentSort_2M", blockMergeSegmentSort<2097152>, blockMergeSegmentSortStats<2097152>},
         {"segmentSortOriginal", segmentSortOriginal},
 
-        {"mergeSort", mergeSort},
+        {"mergeSort", mergeSortInto},
         {"heapSort", heapSort},
         {"std::sort", builtinSort},
-        {"std::stable_sort", stableSort}
+        {"std::stable_sort", stableSort},
+        {"pdqsort", pdqSort},
+        {"timsort", timSort},
+        {"powersort", powerSort}
     };
 }
 
@@ -805,7 +963,35 @@ struct AlgorithmStats {
     int count = 0;
 };
 
-std::vector<TestCase> generateTestCases(size_t size) {
+// Dataset file stem for each test case (same names as the C benchmark and
+// the datasets/ generator: <stem>_<size>.dat, raw native-endian int32)
+std::string datasetStem(const std::string& shortName) {
+    static const std::map<std::string, std::string> stems = {
+        {"Aleatorio", "random"}, {"Ordenado", "sorted"}, {"Inverso", "reverse"},
+        {"K-sorted", "ksorted"}, {"NearlySorted", "nearly_sorted"},
+        {"Duplicados", "duplicates"}, {"Plateau", "plateau"}, {"SegmentSorted", "segmentsorted"},
+        {"Streams", "interleaved_streams"}, {"Sawtooth", "sawtooth"}, {"OrganPipe", "organ_pipe"},
+        {"Zipf", "zipf"}, {"SortedTail", "sorted_tail"}, {"Resets", "periodic_resets"}
+    };
+    auto it = stems.find(shortName);
+    return it == stems.end() ? "" : it->second;
+}
+
+// Loads exactly `size` ints; false (data untouched) if the file is missing or short
+bool loadDataset(const std::string& path, size_t size, std::vector<int>& data) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::vector<int> loaded(size);
+    file.read(reinterpret_cast<char*>(loaded.data()), static_cast<std::streamsize>(size * sizeof(int)));
+    if (static_cast<size_t>(file.gcount()) != size * sizeof(int)) {
+        std::cout << "   [WARN] Dataset " << path << " tiene menos de " << size << " elementos, se ignora\n";
+        return false;
+    }
+    data.swap(loaded);
+    return true;
+}
+
+std::vector<TestCase> generateTestCases(size_t size, const std::string& datasetsDir = "") {
     std::vector<TestCase> testCases;
     
     // Generate test data
@@ -817,6 +1003,12 @@ std::vector<TestCase> generateTestCases(size_t size) {
     auto duplicates_array = generateDuplicatesArray(size, 20);
     auto plateau_array = generatePlateauArray(size, size / 10);
     auto segment_sorted_array = generateSegmentSortedArray(size, size / 5);
+    auto streams_array = generateInterleavedStreamsArray(size, 8);
+    auto sawtooth_array = generateSawtoothArray(size, 100);
+    auto organ_pipe_array = generateOrganPipeArray(size);
+    auto zipf_array = generateZipfArray(size, 1000);
+    auto sorted_tail_array = generateSortedRandomTailArray(size, size / 100);
+    auto resets_array = generatePeriodicResetsArray(size, size / 10);
     
     testCases = {
         {"Aleatorio", "Aleatorio", random_array},
@@ -826,12 +1018,191 @@ std::vector<TestCase> generateTestCases(size_t size) {
         {"Nearly Sorted (5% swaps)", "NearlySorted", nearly_sorted_array},
         {"Con Duplicados (20 unicos)", "Duplicados", duplicates_array},
         {"Plateau (10 segmentos)", "Plateau", plateau_array},
-        {"Segment Sorted (5 segmentos)", "SegmentSorted", segment_sorted_array}
+        {"Segment Sorted (5 segmentos)", "SegmentSorted", segment_sorted_array},
+        // Production-like distributions (values in [0, 1000000])
+        {"Streams intercalados (8 productores)", "Streams", streams_array},
+        {"Sierra (100 dientes)", "Sawtooth", sawtooth_array},
+        {"Organ pipe", "OrganPipe", organ_pipe_array},
+        {"Zipf (s=1, 1000 claves)", "Zipf", zipf_array},
+        {"Ordenado + cola aleatoria (1%)", "SortedTail", sorted_tail_array},
+        {"Reinicios periodicos (10 tramos)", "Resets", resets_array}
     };
+
+    // Prefer the shared datasets (same input as the C/JS runs, PGO training)
+    if (!datasetsDir.empty()) {
+        for (auto& testCase : testCases) {
+            std::string stem = datasetStem(testCase.shortName);
+            if (stem.empty()) continue;
+            std::string path = datasetsDir + "/" + stem + "_" + std::to_string(size) + ".dat";
+            if (loadDataset(path, size, testCase.data)) {
+                testCase.name += " [" + stem + "_" + std::to_string(size) + ".dat]";
+            }
+        }
+    }
     
     return testCases;
 }
 
+// Writes every generated test case as dir/<stem>_<size>.dat (the format
+// loadDataset and c_benchmarks read); with the same seed the files are
+// byte-identical to `c_benchmarks --export-datasets`
+bool exportDatasets(const std::vector<size_t>& sizes, const std::string& dir) {
+    for (size_t size : sizes) {
+        for (const auto& testCase : generateTestCases(size)) {
+            std::string path = dir + "/" + datasetStem(testCase.shortName) + "_" + std::to_string(size) + ".dat";
+            std::ofstream file(path, std::ios::binary);
+            file.write(reinterpret_cast<const char*>(testCase.data.data()),
+                       static_cast<std::streamsize>(testCase.data.size() * sizeof(int)));
+            if (!file) {
+                std::cerr << "[ERROR] No se pudo escribir " << path << "\n";
+                return false;
+            }
+            std::cout << "   [EXPORT] " << path << "\n";
+        }
+    }
+    return true;
+}
+
+// --- Type matrix (--types) ---
+// Same test cases, converted per element type (see element_types.h), against
+// the block merge variants and the library/vendored competitors.
+
+const std::vector<std::string> ELEMENT_TYPES = {
+    "int32", "int64", "double", "string_sso", "string_long", "record64", "record128"
+};
+
+template<typename T>
+struct TypedSorter {
+    std::string name;
+    void (*func)(std::vector<T>&);
+};
+
+template<typename T, size_t BufferSize>
+void typedBlockMergeSegmentSort(std::vector<T>& arr) {
+    segment_sort::block_merge_segment_sort(arr.data(), arr.size(), BufferSize, std::less<T>());
+}
+
+// "DEF" keeps the 64K-element buffer (its size in bytes grows with T);
+// "_256KB" holds the buffer at the int32 default in bytes instead
+template<typename T>
+std::vector<TypedSorter<T>> getTypedSorters() {
+    return {
+        {"blockMergeSegmentSort DEF", typedBlockMergeSegmentSort<T, BLOCK_MERGE_DEFAULT_BUFFER_SIZE>},
+        {"blockMergeSegmentSort_256KB", typedBlockMergeSegmentSort<T, BLOCK_MERGE_DEFAULT_BUFFER_SIZE * sizeof(int) / sizeof(T)>},
+        {"blockMergeSegmentSort_4k", typedBlockMergeSegmentSort<T, 4096>},
+        {"blockMergeSegmentSort AUTO", typedBlockMergeSegmentSort<T, BLOCK_MERGE_AUTO_BUFFER_SIZE>},
+        {"std::sort", [](std::vector<T>& arr) { std::sort(arr.begin(), arr.end()); }},
+        {"std::stable_sort", [](std::vector<T>& arr) { std::stable_sort(arr.begin(), arr.end()); }},
+        {"pdqsort", [](std::vector<T>& arr) { pdqsort(arr.begin(), arr.end()); }},
+        {"timsort", [](std::vector<T>& arr) { gfx::timsort(arr.begin(), arr.end()); }},
+        {"powersort", [](std::vector<T>& arr) {
+            algorithms::powersort<typename std::vector<T>::iterator> sorter;
+            sorter.sort(arr.begin(), arr.end());
+        }}
+    };
+}
+
+template<typename Tag>
+void runElementType(const std::vector<TestCase>& testCases, size_t size, int repetitions, bool validate_results,
+                    perf::CounterGroup* counters, std::vector<BenchmarkResult>& all_results) {
+    using T = typename elem::Storage<Tag>::type;
+    const std::string typeName = elem::Traits<Tag>::name();
+    std::cout << "\n[TIPO] " << typeName << " (" << sizeof(T) << " bytes/elemento, buffer DEF = "
+              << BLOCK_MERGE_DEFAULT_BUFFER_SIZE * sizeof(T) / 1024 << " KB)\n";
+
+    auto sorters = getTypedSorters<T>();
+    auto runCase = [&](const std::vector<T>& data, const std::string& dataType) {
+        for (const auto& sorter : sorters) {
+            auto result = runBenchmark(sorter.func, data, sorter.name, dataType, repetitions, validate_results, counters);
+            result.elementType = typeName;
+            if (result.success) {
+                std::cout << "   " << std::left << std::setw(12) << typeName
+                          << " | " << std::setw(28) << sorter.name
+                          << " | " << std::setw(14) << dataType
+                          << " | " << std::right << std::setw(9) << std::fixed << std::setprecision(3) << result.statistics.median << " ms"
+                          << " | pico aux " << result.memory.peak_bytes << " B, " << result.memory.allocations << " allocs\n";
+                printCounters(result);
+            } else {
+                std::cout << "   " << std::left << std::setw(12) << typeName
+                          << " | " << std::setw(28) << sorter.name
+                          << " | " << std::setw(14) << dataType << " | [ERROR] " << result.error << "\n";
+            }
+            all_results.push_back(result);
+        }
+    };
+
+    for (const auto& testCase : testCases) {
+        runCase(elem::convert<Tag>(testCase.data), testCase.shortName);
+    }
+    if constexpr (std::is_same<T, double>::value) {
+        runCase(elem::signedZeros(size), "SignedZeros");
+    }
+}
+
+// Per element type: algorithms ranked by the mean of their medians over all
+// data types and sizes, and the slowdown of each type against int32
+void analyzeTypeMatrix(const std::vector<BenchmarkResult>& allResults) {
+    std::map<std::string, std::map<std::string, AlgorithmStats>> byElement;
+    for (const auto& res : allResults) {
+        if (!res.success) continue;
+        byElement[res.elementType][res.algorithm].sum += res.statistics.median;
+        byElement[res.elementType][res.algorithm].count++;
+    }
+
+    std::cout << "\n[ANALYSIS] Ranking por tipo de elemento (media de medianas):\n";
+    for (const auto& type : ELEMENT_TYPES) {
+        auto it = byElement.find(type);
+        if (it == byElement.end()) continue;
+        std::vector<std::pair<std::string, double>> averages;
+        for (const auto& [alg, stats] : it->second) {
+            if (stats.count > 0) averages.emplace_back(alg, stats.sum / stats.count);
+        }
+        std::sort(averages.begin(), averages.end(),
+                  [](const auto& a, const auto& b) { return a.second < b.second; });
+
+        std::cout << "   >> " << std::left << std::setw(12) << type << std::right;
+        for (size_t i = 0; i < averages.size(); ++i) {
+            if (i > 0) std::cout << "  |  ";
+            std::cout << (i + 1) << ". " << averages[i].first << " ("
+                      << std::fixed << std::setprecision(3) << averages[i].second << " ms)";
+        }
+        std::cout << "\n";
+    }
+}
+
+void runTypeMatrix(const std::vector<size_t>& sizes, const std::vector<std::string>& types, int repetitions,
+                   bool validate_results, bool use_perf, const std::string& datasetsDir) {
+    std::cout << "[INFO] Matriz de tipos: ";
+    for (size_t i = 0; i < types.size(); ++i) std::cout << types[i] << (i + 1 < types.size() ? ", " : "\n");
+
+    perf::CounterGroup counterGroup;
+    perf::CounterGroup* counters = (use_perf && counterGroup.available()) ? &counterGroup : nullptr;
+    if (use_perf && !counters) {
+        std::cout << "[PERF] Contadores hardware no disponibles (perf_event_open); solo tiempo de reloj\n";
+    }
+
+    std::vector<BenchmarkResult> all_results;
+    for (size_t size : sizes) {
+        std::cout << "\n[SIZE] Probando con arrays de tamano: " << size << "\n";
+        std::cout << std::string(60, '-') << "\n";
+        auto testCases = generateTestCases(size, datasetsDir);
+
+        for (const auto& type : types) {
+            if (type == "int32") runElementType<int>(testCases, size, repetitions, validate_results, counters, all_results);
+            else if (type == "int64") runElementType<int64_t>(testCases, size, repetitions, validate_results, counters, all_results);
+            else if (type == "double") runElementType<double>(testCases, size, repetitions, validate_results, counters, all_results);
+            else if (type == "string_sso") runElementType<elem::ShortString>(testCases, size, repetitions, validate_results, counters, all_results);
+            else if (type == "string_long") runElementType<elem::LongString>(testCases, size, repetitions, validate_results, counters, all_results);
+            else if (type == "record64") runElementType<elem::Record<64>>(testCases, size, repetitions, validate_results, counters, all_results);
+            else if (type == "record128") runElementType<elem::Record<128>>(testCases, size, repetitions, validate_results, counters, all_results);
+        }
+    }
+
+    std::cout << "\n" << std::string(100, '=') << "\n";
+    std::cout << "[SUCCESS] Matriz de tipos completada!\n";
+    exportResults(all_results, sizes, repetitions, datasetsDir, "results_types.json");
+    analyzeTypeMatrix(all_results);
+}
 
 void analyzeResults(const std::vector<BenchmarkResult>& allResults) {
     if (allResults.empty()) {
@@ -914,27 +1285,101 @@ void analyzeResults(const std::vector<BenchmarkResult>& allResults) {
     }
 }
 
-void runBenchmarks(const std::vector<size_t>& sizes, int repetitions = 10, bool validate_results = true) {
+// One console line with the per-element counter medians of a result
+void printCounters(const BenchmarkResult& result) {
+    if (result.counters.empty() || !result.counters[0].any()) return;
+    double n = static_cast<double>(std::max<size_t>(result.size, 1));
+    double cycles = perf::medianCounter(result.counters, perf::CYCLES);
+    double instructions = perf::medianCounter(result.counters, perf::INSTRUCTIONS);
+    std::cout << "     perf:" << std::fixed << std::setprecision(2);
+    if (cycles > 0) std::cout << " IPC " << instructions / cycles << " |";
+    for (int c = 0; c < perf::NUM_COUNTERS; ++c) {
+        if (!result.counters[0].valid[c]) continue;
+        std::cout << " " << perf::counterName(c) << "/elem " << perf::medianCounter(result.counters, c) / n;
+    }
+    std::cout << "\n";
+}
+
+// Detected cache sizes and what the AUTO buffer resolves to for int
+void printCacheInfo() {
+    const segment_sort::CacheInfo& cache = segment_sort::cache_info();
+    std::cout << "[CACHE] L1d " << cache.l1d / 1024 << " KB, L2 " << cache.l2 / 1024 << " KB, L3 " << cache.l3 / 1024 << " KB"
+              << (cache.detected ? "" : " (valores por defecto)")
+              << " -> buffer AUTO (int, n grande) = " << segment_sort::auto_buffer_size<int>(size_t(1) << 40) << " elementos\n";
+}
+
+// Huge page availability, for reading the --scratch results
+void printScratchInfo() {
+    std::string thp = "no disponible";
+    std::ifstream thp_file("/sys/kernel/mm/transparent_hugepage/enabled");
+    if (thp_file) std::getline(thp_file, thp);
+    size_t reserved = 0;
+    std::ifstream meminfo("/proc/meminfo");
+    std::string line;
+    while (std::getline(meminfo, line)) {
+        if (line.rfind("HugePages_Total:", 0) == 0) reserved = std::strtoull(line.c_str() + 16, nullptr, 10);
+    }
+    std::cout << "[SCRATCH] THP: " << thp << " | huge pages reservadas: " << reserved
+              << " (0 = huge usa madvise/THP) | buffers >= 2MB via mmap, fuera del contador de memoria\n\n";
+}
+
+// One console line with the internal counters of a block merge result
+void printSortStats(const BenchmarkResult& result) {
+    if (!result.has_sort_stats) return;
+    const segment_sort::SortStats& st = result.sort_stats;
+    double n = static_cast<double>(std::max<size_t>(result.size, 1));
+    std::cout << "     stats:" << std::fixed << std::setprecision(2)
+              << " cmp/elem " << st.comparisons / n
+              << " | moves/elem " << st.moves / n
+              << " | runs " << st.runs
+              << " | redes " << st.network_sorts
+              << " | buffer " << st.buffer_merges
+              << " | block " << st.block_merges
+              << " | symmerge " << st.symmerge_splits
+              << " | rot.elem " << st.rotated_elements
+              << " | depth " << st.max_recursion_depth
+              << " | stack " << st.max_stack_depth
+              << " | limite " << st.buffer_elements << " elem (" << st.buffer_bytes / 1024 << " KB)\n";
+}
+
+void runBenchmarks(const std::vector<size_t>& sizes, int repetitions = 10, bool validate_results = true, bool use_perf = false,
+                   const std::string& datasetsDir = "", bool scratch_policies = false) {
     std::cout << "[INFO] Iniciando benchmarks de Segment Sort (Metodologia Academica)...\n\n";
-    std::cout << "[CONFIG] " << repetitions << " repeticiones, analisis estadistico completo\n\n";
+    std::cout << "[CONFIG] " << repetitions << " repeticiones, analisis estadistico completo\n";
+    printCacheInfo();
+    std::cout << "\n";
     std::cout << std::string(100, '=') << "\n";
     std::cout << "| Algoritmo                   | Tamano | Tipo de Datos        | Media (ms) | Mediana (ms) | Desv.Std | Estado |\n";
     std::cout << std::string(100, '=') << "\n";
 
-    auto sorters = getSorters();
+    auto sorters = scratch_policies ? getScratchSorters() : getSorters();
+    if (scratch_policies) printScratchInfo();
     std::vector<BenchmarkResult> all_results;
 
+    // Optional hardware counters; degrade to wall-clock only if unavailable
+    perf::CounterGroup counterGroup;
+    perf::CounterGroup* counters = nullptr;
+    if (use_perf) {
+        if (counterGroup.available()) {
+            counters = &counterGroup;
+            std::cout << "[PERF] Contadores hardware habilitados\n\n";
+        } else {
+            std::cout << "[PERF] Contadores hardware no disponibles (perf_event_open); solo tiempo de reloj\n\n";
+        }
+    }
+
     for (size_t size : sizes) {
         std::cout << "\n[SIZE] Probando con arrays de tamano: " << size << "\n";
         std::cout << std::string(60, '-') << "\n";
 
-        auto testCases = generateTestCases(size);
+        auto testCases = generateTestCases(size, datasetsDir);
 
         for (const auto& testCase : testCases) {
             std::cout << "\n[TEST] " << testCase.name << ":\n";
 
             for (const auto& sorter : sorters) {
-                auto result = runBenchmark(sorter.func, testCase.data, sorter.name, testCase.shortName, repetitions, validate_results);
+                auto result = runBenchmark(sorter.func, testCase.data, sorter.name, testCase.shortName, repetitions, validate_results, counters);
+                collectSortStats(sorter.stats_func, testCase.data, result);
                 std::string status = result.success ? "[OK]" : "[ERROR]";
 
                 if (result.success) {
@@ -945,6 +1390,11 @@ void runBenchmarks(const std::vector<size_t>& sizes, int repetitions = 10, bool
                               << " | " << std::setw(11) << result.statistics.median
                               << " | " << std::setw(8) << result.statistics.std
                               << " | " << status << "\n";
+                    std::cout << "     memoria: pico aux " << result.memory.peak_bytes << " bytes | "
+                              << result.memory.allocations << " allocs | maxrss +"
+                              << result.memory.maxrss_delta_kb << " KB\n";
+                    printCounters(result);
+                    printSortStats(result);
 
                     all_results.push_back(result);
                 } else {
@@ -967,18 +1417,160 @@ void runBenchmarks(const std::vector<size_t>& sizes, int repetitions = 10, bool
     std::cout << "[SUCCESS] Benchmarks completados!\n";
 
     // Export results to JSON
-    exportResults(all_results, sizes, repetitions);
+    exportResults(all_results, sizes, repetitions, datasetsDir, scratch_policies ? "results_scratch.json" : "results.json");
 
     // Análisis comparativo resumido
     analyzeResults(all_results);
 }
 
-void exportResults(const std::vector<BenchmarkResult>& results, const std::vector<size_t>& sizes, int repetitions) {
+// Regression mode: reruns the algorithm x dataType x size entries of a baseline
+// JSON with its seed (and datasets), compares medians with a bootstrap CI and
+// returns 1 if any variant regressed by more than `threshold` or failed.
+int runRegression(const std::string& baselinePath, double threshold, int repetitions, bool validate_results,
+                  const std::string& datasetsDir, bool seed_given, uint64_t seed) {
+    regression::Baseline baseline;
+    std::string error = regression::loadBaseline(baselinePath, baseline);
+    if (!error.empty()) {
+        std::cerr << "[ERROR] Baseline: " << error << "\n";
+        return 1;
+    }
+
+    if (!seed_given && baseline.has_seed) seed = baseline.seed;
+    std::string datasets = datasetsDir.empty() ? baseline.datasets : datasetsDir;
+    rng.setSeed(seed);
+
+    std::cout << "[REGRESSION] Baseline: " << baselinePath << " (" << baseline.entries.size() << " resultados)\n";
+    std::cout << "   - Umbral: " << std::fixed << std::setprecision(1) << threshold * 100 << "%"
+              << " | Repeticiones: " << repetitions << " | Seed: " << seed << "\n";
+    if (!datasets.empty()) std::cout << "   - Datasets: " << datasets << "\n";
+    std::cout << "   - Regresion = IC 95% bootstrap de mediana(actual)/mediana(baseline) entero por encima de 1+umbral\n\n";
+
+    auto sorters = getSorters();
+    std::vector<std::string> skipped;
+    for (const auto& entry : baseline.entries) {
+        bool known = std::any_of(sorters.begin(), sorters.end(),
+                                 [&](const Sorter& s) { return s.name == entry.algorithm; });
+        if (!known && std::find(skipped.begin(), skipped.end(), entry.algorithm) == skipped.end()) {
+            skipped.push_back(entry.algorithm);
+        }
+    }
+    for (const auto& name : skipped) {
+        std::cout << "[SKIP] Algoritmo sin equivalente en C++: " << name << "\n";
+    }
+
+    struct Row {
+        BenchmarkResult result;
+        regression::Comparison comparison;
+    };
+    std::vector<Row> rows;
+    std::vector<BenchmarkResult> all_results;
+
+    // Sizes in baseline order, so the LCG stream reproduces the same arrays
+    for (size_t size : baseline.sizes) {
+        std::cout << "[SIZE] " << size << "...\n";
+        auto testCases = generateTestCases(size, datasets);
+        for (const auto& testCase : testCases) {
+            for (const auto& sorter : sorters) {
+                auto match = std::find_if(baseline.entries.begin(), baseline.entries.end(),
+                    [&](const regression::BaselineEntry& e) {
+                        return e.size == size && e.dataType == testCase.shortName && e.algorithm == sorter.name;
+                    });
+                if (match == baseline.entries.end()) continue;
+
+                Row row;
+                row.result = runBenchmark(sorter.func, testCase.data, sorter.name, testCase.shortName, repetitions, validate_results);
+                if (row.result.success) {
+                    row.comparison = regression::compare(*match, row.result.times, threshold);
+                } else {
+                    row.comparison.baseline_median = match->median;
+                }
+                all_results.push_back(row.result);
+                rows.push_back(row);
+            }
+        }
+    }
+
+    if (rows.empty()) {
+        std::cerr << "[ERROR] Ninguna entrada del baseline coincide con los algoritmos/tipos de este binario\n";
+        return 1;
+    }
+
+    // Diff table
+    int regressions = 0, failures = 0, improvements = 0;
+    double log_ratio_sum = 0.0;
+    int compared = 0;
+    std::cout << "\n" << std::string(118, '=') << "\n";
+    std::cout << "| Algoritmo                   | Tamano | Tipo de Datos  | Base (ms) | Actual (ms) |  Delta  |     IC 95%        | Veredicto  |\n";
+    std::cout << std::string(118, '=') << "\n";
+    for (const auto& row : rows) {
+        const auto& r = row.result;
+        const auto& c = row.comparison;
+        std::cout << "| " << std::left << std::setw(27) << r.algorithm
+                  << " | " << std::right << std::setw(6) << r.size
+                  << " | " << std::left << std::setw(14) << r.dataType
+                  << " | " << std::right << std::setw(9) << std::fixed << std::setprecision(3) << c.baseline_median;
+        if (!r.success) {
+            failures++;
+            std::cout << " | " << std::setw(11) << "ERROR" << " | " << std::setw(7) << "-"
+                      << " | " << std::setw(17) << "-" << " | " << std::left << std::setw(10) << "FALLO" << " |\n";
+            std::cout << "    Error: " << r.error << "\n";
+            continue;
+        }
+
+        log_ratio_sum += std::log(c.ratio);
+        compared++;
+
+        std::string verdict = "ok";
+        if (c.regression) {
+            verdict = "REGRESION";
+            regressions++;
+        } else if (c.improvement) {
+            verdict = "mejora";
+            improvements++;
+        } else if (std::fabs(c.ratio - 1.0) > threshold) {
+            verdict = "ruido";  // Median moved past the threshold, CI does not confirm it
+        }
+
+        std::ostringstream delta, ci;
+        delta << std::showpos << std::fixed << std::setprecision(1) << (c.ratio - 1.0) * 100 << "%";
+        ci << std::showpos << std::fixed << std::setprecision(1)
+           << "[" << (c.ci_low - 1.0) * 100 << "%, " << (c.ci_high - 1.0) * 100 << "%]";
+        std::cout << " | " << std::setw(11) << c.current_median
+                  << " | " << std::setw(7) << delta.str()
+                  << " | " << std::setw(17) << ci.str()
+                  << " | " << std::left << std::setw(10) << verdict << " |\n";
+    }
+    std::cout << std::string(118, '=') << "\n";
+
+    exportResults(all_results, baseline.sizes, repetitions, datasets, "regression_results.json");
+
+    // The CI only covers run-to-run noise within this process; a shift of every
+    // variant at once usually means the machine (frequency, load) changed
+    if (compared > 0) {
+        double drift = std::exp(log_ratio_sum / compared) - 1.0;
+        std::cout << "[REGRESSION] Deriva global (media geometrica de ratios): " << std::showpos << std::fixed
+                  << std::setprecision(1) << drift * 100 << "%" << std::noshowpos << "\n";
+        if (std::fabs(drift) > threshold) {
+            std::cout << "[WARN] Todas las variantes se movieron a la vez: compruebe que la maquina y la carga\n"
+                      << "       son las del baseline antes de dar por buena una regresion\n";
+        }
+    }
+    std::cout << "[REGRESSION] " << rows.size() << " comparaciones: " << regressions << " regresiones, "
+              << failures << " fallos, " << improvements << " mejoras\n";
+    if (regressions > 0 || failures > 0) {
+        std::cout << "[FAIL] Regresion por encima del " << std::setprecision(1) << threshold * 100 << "%\n";
+        return 1;
+    }
+    std::cout << "[PASS] Sin regresiones\n";
+    return 0;
+}
+
+void exportResults(const std::vector<BenchmarkResult>& results, const std::vector<size_t>& sizes, int repetitions,
+                   const std::string& datasetsDir, const std::string& filename) {
     auto now = std::chrono::system_clock::now();
     auto time_t = std::chrono::system_clock::to_time_t(now);
     auto tm = *std::localtime(&time_t);
     
-    std::string filename = "results.json";
     std::ofstream file(filename);
     if (!file.is_open()) {
         std::cerr << "[ERROR] No se pudo crear el archivo de resultados: " << filename << " Error: " << strerror(errno) << "\n";
@@ -990,6 +1582,15 @@ void exportResults(const std::vector<BenchmarkResult>& results, const std::vecto
     file << "    \"timestamp\": \"" << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << "\",\n";
     file << "    \"seed\": " << rng.getSeed() << ",\n";
     file << "    \"repetitions\": " << repetitions << ",\n";
+    file << "    \"sizes\": [";
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        file << sizes[i] << (i + 1 < sizes.size() ? ", " : "");
+    }
+    file << "],\n";
+    if (!datasetsDir.empty()) file << "    \"datasets\": \"" << datasetsDir << "\",\n";
+    const segment_sort::CacheInfo& cache = segment_sort::cache_info();
+    file << "    \"cache\": {\"l1d\": " << cache.l1d << ", \"l2\": " << cache.l2 << ", \"l3\": " << cache.l3
+         << ", \"detected\": " << (cache.detected ? "true" : "false") << "},\n";
     file << "    \"methodology\": \"Academic Rigor Benchmarking v1.0\"\n";
     file << "  },\n";
     file << "  \"results\": [\n";
@@ -1000,6 +1601,8 @@ void exportResults(const std::vector<BenchmarkResult>& results, const std::vecto
         file << "      \"algorithm\": \"" << result.algorithm << "\",\n";
         file << "      \"size\": " << result.size << ",\n";
         file << "      \"dataType\": \"" << result.dataType << "\",\n";
+        file << "      \"elementType\": \"" << result.elementType << "\",\n";
+        file << "      \"elementBytes\": " << result.elementBytes << ",\n";
         file << "      \"repetitions\": " << result.repetitions << ",\n";
         file << "      \"success\": " << (result.success ? "true" : "false") << ",\n";
         
@@ -1013,6 +1616,57 @@ void exportResults(const std::vector<BenchmarkResult>& results, const std::vecto
             file << "        \"min\": " << result.statistics.min << ",\n";
             file << "        \"max\": " << result.statistics.max << "\n";
             file << "      },\n";
+
+            file << "      \"memory\": {\n";
+            file << "        \"peakAuxBytes\": " << result.memory.peak_bytes << ",\n";
+            file << "        \"allocations\": " << result.memory.allocations << ",\n";
+            file << "        \"allocatedBytes\": " << result.memory.allocated_bytes << ",\n";
+            file << "        \"maxRssDeltaKB\": " << result.memory.maxrss_delta_kb << "\n";
+            file << "      },\n";
+
+            // Hardware counters: median over runs, only those that were measured
+            if (!result.counters.empty() && result.counters[0].any()) {
+                file << "      \"counters\": {\n";
+                bool first = true;
+                for (int c = 0; c < perf::NUM_COUNTERS; ++c) {
+                    if (!result.counters[0].valid[c]) continue;
+                    if (!first) file << ",\n";
+                    file << "        \"" << perf::counterName(c) << "\": "
+                         << static_cast<uint64_t>(perf::medianCounter(result.counters, c) + 0.5);
+                    first = false;
+                }
+                file << "\n      },\n";
+            }
+
+            // Block merge internals (one untimed run, SEGMENT_SORT_STATS builds only)
+            if (result.has_sort_stats) {
+                const segment_sort::SortStats& st = result.sort_stats;
+                size_t buckets = segment_sort::SORT_STATS_HISTOGRAM_BUCKETS;
+                while (buckets > 0 && st.run_length_histogram[buckets - 1] == 0) --buckets;
+                file << "      \"sortStats\": {\n";
+                file << "        \"comparisons\": " << st.comparisons << ",\n";
+                file << "        \"moves\": " << st.moves << ",\n";
+                file << "        \"networkSorts\": " << st.network_sorts << ",\n";
+                file << "        \"bufferMerges\": " << st.buffer_merges << ",\n";
+                file << "        \"blockMerges\": " << st.block_merges << ",\n";
+                file << "        \"symMergeSplits\": " << st.symmerge_splits << ",\n";
+                file << "        \"skippedMerges\": " << st.skipped_merges << ",\n";
+                file << "        \"rotations\": " << st.rotations << ",\n";
+                file << "        \"rotatedElements\": " << st.rotated_elements << ",\n";
+                file << "        \"maxRotation\": " << st.max_rotation << ",\n";
+                file << "        \"maxRecursionDepth\": " << st.max_recursion_depth << ",\n";
+                file << "        \"maxStackDepth\": " << st.max_stack_depth << ",\n";
+                file << "        \"bufferElements\": " << st.buffer_elements << ",\n";
+                file << "        \"bufferBytes\": " << st.buffer_bytes << ",\n";
+                file << "        \"runs\": " << st.runs << ",\n";
+                file << "        \"runLengthHistogram\": [";
+                for (size_t b = 0; b < buckets; ++b) {
+                    file << st.run_length_histogram[b];
+                    if (b + 1 < buckets) file << ", ";
+                }
+                file << "]\n";
+                file << "      },\n";
+            }
             
             file << "      \"allTimes\": [";
             for (size_t j = 0; j < result.times.size(); ++j) {
@@ -1038,17 +1692,33 @@ void exportResults(const std::vector<BenchmarkResult>& results, const std::vecto
 
 // Command line argument parsing
 void printHelp() {
-    std::cout << "Uso: cpp_benchmarks [sizes...] [--reps repetitions] [--seed seed]\n\n";
+    std::cout << "Uso: cpp_benchmarks [sizes...] [--reps repetitions] [--seed seed] [--perf] [--datasets dir]\n";
+    std::cout << "     cpp_benchmarks --baseline results.json [--threshold 3%] [--reps repetitions]\n\n";
     std::cout << "Ejemplos:\n";
     std::cout << "  cpp_benchmarks                # Ejecuta con tamano 100000, 10 repeticiones\n";
     std::cout << "  cpp_benchmarks 50000          # Ejecuta solo para tamano 50000\n";
     std::cout << "  cpp_benchmarks 10000 50000    # Ejecuta para varios tamanos\n";
     std::cout << "  cpp_benchmarks 100000 --reps 30  # Ejecuta tamano 100000 con 30 repeticiones\n";
-    std::cout << "  cpp_benchmarks --seed 42 50000 --reps 5  # Con seed específico\n\n";
+    std::cout << "  cpp_benchmarks --seed 42 50000 --reps 5  # Con seed específico\n";
+    std::cout << "  cpp_benchmarks --baseline base.json --threshold 3%  # Falla (exit 1) si algo empeora >3%\n\n";
     std::cout << "Argumentos:\n";
     std::cout << "  sizes...              Tamanos de arrays a probar (por defecto: 100000)\n";
     std::cout << "  --reps, -r N         NNumero de repeticiones por configuracion (por defecto: 10)\n";
     std::cout << "  --seed S             Seed para generacion deterministica (por defecto: 12345)\n";
+    std::cout << "  --perf               Contadores hardware (cycles, instructions, branch/L1d/LLC/dTLB misses)\n";
+    std::cout << "  --scratch            Solo block merge (buffer n/2) con buffer normal, huge pages, NUMA local\n";
+    std::cout << "                       y ambos, frente a std::stable_sort (escribe results_scratch.json)\n";
+    std::cout << "  --datasets DIR       Carga DIR/<tipo>_<tamano>.dat si existe (p.ej. ../../../datasets)\n";
+    std::cout << "  --baseline FILE      Modo regresion: repite los algoritmos/tipos/tamanos de FILE con su seed,\n";
+    std::cout << "                       imprime la tabla de diferencias y escribe regression_results.json\n";
+    std::cout << "  --threshold X%       Regresion si el IC 95% de la mediana supera +X% (por defecto: 3%)\n";
+    std::cout << "  --types LIST         Matriz de tipos en vez de int: all o lista separada por comas de\n";
+    std::cout << "                       int32,int64,double,string_sso,string_long,record64,record128\n";
+    std::cout << "                       (escribe results_types.json)\n";
+    std::cout << "  --export-datasets DIR  Escribe DIR/<tipo>_<tamano>.dat de cada caso generado y sale\n";
+    std::cout << "                       (mismo seed => mismos ficheros que c_benchmarks --export-datasets)\n\n";
+    std::cout << "Compilado con -DSEGMENT_SORT_STATS, cada blockMergeSegmentSort anade \"sortStats\" al JSON\n";
+    std::cout << "(comparaciones, movimientos, merges con buffer vs SymMerge, rotaciones, profundidad, runs).\n";
 }
 
 int main(int argc, char* argv[]) {
@@ -1056,6 +1726,14 @@ int main(int argc, char* argv[]) {
     int repetitions = 10;
     uint64_t seed = 12345;
     bool validate_results = true;
+    bool use_perf = false;
+    bool scratch_policies = false;
+    bool seed_given = false;
+    std::string datasets_dir;
+    std::string baseline_path;
+    std::string export_dir;
+    std::vector<std::string> types;
+    double threshold = 0.03;
     
     // Parse command line arguments
     for (int i = 1; i < argc; ++i) {
@@ -1071,9 +1749,52 @@ int main(int argc, char* argv[]) {
         } else if (arg == "--seed") {
             if (i + 1 < argc) {
                 seed = std::stoull(argv[++i]);
+                seed_given = true;
             }
         } else if (arg == "--no-validate") {
             validate_results = false;
+        } else if (arg == "--perf") {
+            use_perf = true;
+        } else if (arg == "--scratch") {
+            scratch_policies = true;
+        } else if (arg == "--datasets") {
+            if (i + 1 < argc) {
+                datasets_dir = argv[++i];
+            }
+        } else if (arg == "--types") {
+            if (i + 1 < argc) {
+                std::string list = argv[++i];
+                if (list == "all") {
+                    types = ELEMENT_TYPES;
+                } else {
+                    std::stringstream stream(list);
+                    std::string type;
+                    while (std::getline(stream, type, ',')) {
+                        if (std::find(ELEMENT_TYPES.begin(), ELEMENT_TYPES.end(), type) == ELEMENT_TYPES.end()) {
+                            std::cerr << "Tipo desconocido: " << type << "\n";
+                            printHelp();
+                            return 1;
+                        }
+                        types.push_back(type);
+                    }
+                }
+            }
+        } else if (arg == "--export-datasets") {
+            if (i + 1 < argc) {
+                export_dir = argv[++i];
+            }
+        } else if (arg == "--baseline") {
+            if (i + 1 < argc) {
+                baseline_path = argv[++i];
+            }
+        } else if (arg == "--threshold") {
+            if (i + 1 < argc) {
+                threshold = regression::parseThreshold(argv[++i]);
+                if (threshold < 0) {
+                    std::cerr << "Umbral invalido: " << argv[i] << " (p.ej. 3%)\n";
+                    return 1;
+                }
+            }
         } else {
             // Try to parse as size
             try {
@@ -1087,12 +1808,23 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    if (!baseline_path.empty()) {
+        if (!sizes.empty()) {
+            std::cout << "[WARN] Con --baseline se usan los tamanos del baseline; se ignoran los indicados\n";
+        }
+        return runRegression(baseline_path, threshold, repetitions, validate_results, datasets_dir, seed_given, seed);
+    }
+
     if (sizes.empty()) {
         sizes.push_back(100000);
     }
     
     // Set seed for deterministic results
     rng.setSeed(seed);
+
+    if (!export_dir.empty()) {
+        return exportDatasets(sizes, export_dir) ? 0 : 1;
+    }
     
     std::cout << "[CONFIG] Configuracion:\n";
     std::cout << "   - Tamanos: ";
@@ -1103,10 +1835,16 @@ int main(int argc, char* argv[]) {
     std::cout << "\n";
     std::cout << "   - Repeticiones: " << repetitions << "\n";
     std::cout << "   - Seed: " << seed << "\n";
-    std::cout << "   - Validacion: " << (validate_results ? "Habilitada" : "Deshabilitada") << "\n\n";
+    std::cout << "   - Validacion: " << (validate_results ? "Habilitada" : "Deshabilitada") << "\n";
+    if (!datasets_dir.empty()) std::cout << "   - Datasets: " << datasets_dir << "\n";
+    std::cout << "\n";
     
     // Run benchmarks
-    runBenchmarks(sizes, repetitions, validate_results);
+    if (!types.empty()) {
+        runTypeMatrix(sizes, types, repetitions, validate_results, use_perf, datasets_dir);
+    } else {
+        runBenchmarks(sizes, repetitions, validate_results, use_perf, datasets_dir, scratch_policies);
+    }
     
     return 0;
 }
\ No newline at end of file
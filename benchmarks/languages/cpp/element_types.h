@@ -0,0 +1,130 @@
+/**
+ * Element Types for the C++ Type Matrix Benchmark
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Every element type is built from the int test cases of cpp_benchmarks.cpp
+ * with a strictly increasing map of the int value, so runs, duplicates and
+ * plateaus are exactly the same for every type and only the element
+ * (size, compare cost, copy cost) changes:
+ * - int32, int64       value / value * 1000003 - 2^40 (full 64-bit spread)
+ * - double             (value - 500) * 0.25, zeros alternate +0.0 / -0.0.
+ *                      The inputs never contain NaN (operator< would not be a
+ *                      strict weak ordering).
+ * - string_sso         "k" + 11 zero-padded digits (12 chars, inline in
+ *                      libstdc++/libc++ small-string storage)
+ * - string_long        32-char shared prefix + 11 digits (heap allocated,
+ *                      every compare scans the prefix)
+ * - record64/128       64/128-byte POD, ordered by its int64 key; the payload
+ *                      is copied along with every move
+ */
+
+#ifndef ELEMENT_TYPES_H
+#define ELEMENT_TYPES_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+
+namespace elem {
+
+    // POD record of Bytes bytes ordered by key (the payload only adds copy cost)
+    template<size_t Bytes>
+    struct Record {
+        int64_t key;
+        uint64_t payload[(Bytes - sizeof(int64_t)) / sizeof(uint64_t)];
+
+        bool operator<(const Record& other) const { return key < other.key; }
+    };
+
+    static_assert(sizeof(Record<64>) == 64, "record64 must be 64 bytes");
+    static_assert(sizeof(Record<128>) == 128, "record128 must be 128 bytes");
+
+    // Name and order-preserving constructor from (int value, position)
+    template<typename T> struct Traits;
+
+    template<> struct Traits<int> {
+        static const char* name() { return "int32"; }
+        static int make(int v, size_t) { return v; }
+    };
+
+    template<> struct Traits<int64_t> {
+        static const char* name() { return "int64"; }
+        static int64_t make(int v, size_t) { return static_cast<int64_t>(v) * 1000003 - (int64_t(1) << 40); }
+    };
+
+    template<> struct Traits<double> {
+        static const char* name() { return "double"; }
+        static double make(int v, size_t index) {
+            double d = (v - 500) * 0.25;
+            if (d == 0.0 && (index & 1)) d = -0.0; // Equal to +0.0 under operator<
+            return d;
+        }
+    };
+
+    // std::string is used twice (short and long), so it gets tag types
+    struct ShortString { using type = std::string; };
+    struct LongString { using type = std::string; };
+
+    template<> struct Traits<ShortString> {
+        static const char* name() { return "string_sso"; }
+        static std::string make(int v, size_t) {
+            char text[16];
+            std::snprintf(text, sizeof(text), "k%011d", v);
+            return text;
+        }
+    };
+
+    template<> struct Traits<LongString> {
+        static const char* name() { return "string_long"; }
+        static std::string make(int v, size_t) {
+            char text[48];
+            std::snprintf(text, sizeof(text), "https://example.com/api/v1/items/%011d", v);
+            return text;
+        }
+    };
+
+    template<size_t Bytes> struct Traits<Record<Bytes>> {
+        static const char* name() { return Bytes == 64 ? "record64" : "record128"; }
+        static Record<Bytes> make(int v, size_t index) {
+            Record<Bytes> r;
+            r.key = v;
+            for (auto& word : r.payload) word = index;
+            return r;
+        }
+    };
+
+    // Storage type: the tags map to std::string, everything else to itself
+    template<typename Tag> struct Storage { using type = Tag; };
+    template<> struct Storage<ShortString> { using type = std::string; };
+    template<> struct Storage<LongString> { using type = std::string; };
+
+    template<typename Tag>
+    std::vector<typename Storage<Tag>::type> convert(const std::vector<int>& values) {
+        std::vector<typename Storage<Tag>::type> out;
+        out.reserve(values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            out.push_back(Traits<Tag>::make(values[i], i));
+        }
+        return out;
+    }
+
+    // Extra double-only case: +0.0, -0.0 and a few small values of both signs,
+    // so a sort that orders zeros by bit pattern (or drops -0.0) shows up
+    inline std::vector<double> signedZeros(size_t size) {
+        std::vector<double> out(size);
+        for (size_t i = 0; i < size; ++i) {
+            switch ((i * 2654435761u) % 4) {
+                case 0: out[i] = 0.0; break;
+                case 1: out[i] = -0.0; break;
+                case 2: out[i] = static_cast<double>(i % 7) * 1e-3; break;
+                default: out[i] = -static_cast<double>(i % 5) * 1e-3; break;
+            }
+        }
+        return out;
+    }
+
+} // namespace elem
+
+#endif // ELEMENT_TYPES_H
@@ -0,0 +1,101 @@
+/** @author Sebastian Wild (wild@liverpool.ac.uk) */
+
+// Reduced to what powersort.h needs from the upstream
+// nearly-optimal-mergesort-code repository (src/algorithms/merging.h):
+// the two stable merging methods and the run detection helper.
+// The unstable bitonic and sentinel variants are not included.
+
+#ifndef MERGESORTS_MERGING_H
+#define MERGESORTS_MERGING_H
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <string>
+
+namespace algorithms {
+
+	/**
+	 * Ways to merge two adjacent runs with a buffer.
+	 * COPY_BOTH copies both runs to the buffer and merges back;
+	 * COPY_SMALLER copies only the shorter run and merges from that side.
+	 */
+	enum merging_methods {
+		COPY_SMALLER,
+		COPY_BOTH,
+	};
+
+	inline std::string to_string(merging_methods method) {
+		switch (method) {
+			case COPY_SMALLER: return "COPY_SMALLER";
+			case COPY_BOTH: return "COPY_BOTH";
+		}
+		assert(false);
+		__builtin_unreachable();
+	}
+
+
+	/**
+	 * Merges the adjacent sorted runs [l,m) and [m,r) stably, using B as
+	 * buffer; B must have room for r-l elements.
+	 */
+	template<merging_methods mergingMethod, typename Iter, typename Iter2>
+	void merge_runs(Iter l, Iter m, Iter r, Iter2 B) {
+		assert(l <= m && m <= r);
+		if (l == m || m == r) return;
+		switch (mergingMethod) {
+			case COPY_BOTH: {
+				Iter2 endB = std::copy(l, r, B);
+				Iter2 i = B, j = B + (m - l);
+				Iter2 const midB = j;
+				Iter k = l;
+				while (i < midB && j < endB) *k++ = (*j < *i) ? *j++ : *i++;
+				while (i < midB) *k++ = *i++;
+				while (j < endB) *k++ = *j++;
+				break;
+			}
+			case COPY_SMALLER: {
+				if (m - l <= r - m) {
+					// left run to buffer, merge left to right
+					Iter2 endB = std::copy(l, m, B);
+					Iter2 i = B;
+					Iter j = m, k = l;
+					while (i < endB && j < r) *k++ = (*j < *i) ? *j++ : *i++;
+					while (i < endB) *k++ = *i++;
+				} else {
+					// right run to buffer, merge right to left
+					Iter2 endB = std::copy(m, r, B);
+					Iter2 j = endB;
+					Iter i = m, k = r;
+					while (i > l && j > B) *--k = (*(j-1) < *(i-1)) ? *--i : *--j;
+					while (j > B) *--k = *--j;
+				}
+				break;
+			}
+		}
+	}
+
+
+	/**
+	 * Returns the end of the run starting at begin: weakly increasing, or
+	 * strictly decreasing, in which case it is reversed in place.
+	 */
+	template<typename Iter>
+	Iter extend_and_reverse_run_right(Iter begin, Iter end) {
+		Iter j = begin;
+		if (j == end) return j;
+		if (j+1 == end) return j+1;
+		if (*(j+1) < *j) {
+			// strictly decreasing
+			while (j+1 < end && *(j+1) < *j) ++j;
+			std::reverse(begin, j+1);
+		} else {
+			// weakly increasing
+			while (j+1 < end && !(*(j+1) < *j)) ++j;
+		}
+		return j+1;
+	}
+
+}
+
+#endif //MERGESORTS_MERGING_H
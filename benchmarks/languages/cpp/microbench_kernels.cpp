@@ -0,0 +1,362 @@
+/**
+ * Kernel Microbenchmarks - Block Merge Segment Sort (Google Benchmark)
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Times the building blocks in isolation, so a regression in one kernel is
+ * not averaged away by the end-to-end numbers of cpp_benchmarks.cpp:
+ * - detect_segment           (full scan of an array made of runs)
+ * - merge_with_buffer_left   (balanced and skewed halves)
+ * - merge_with_buffer_right  (balanced and skewed halves)
+ * - merge_bidirectional      (both runs copied, merged from both ends)
+ * - small-buffer merge       (SymMerge vs in-place block merge)
+ * - merge passes             (forward-only vs bidirectional, random and k-sorted)
+ * - merge prefetch distance  (both merge directions, 0/256/512/2048 bytes)
+ * - split search             (std::lower_bound vs branchless_lower_bound)
+ * - rotation                 (std::rotate, triple reversal, rotate_with_buffer)
+ * - SegmentSort::Iterator::next() (full drain, heap setup excluded)
+ *
+ * Arguments are {n, run length} or {n, left share in %}. Run length 0 means
+ * random data (runs of ~2); negative lengths are descending runs, which
+ * detect_segment reverses in place.
+ *
+ * Every benchmark reports:
+ *   items_per_second  elements/sec
+ *   time/elem         seconds per element (Google Benchmark prints the SI
+ *                     prefix, so "1.25n" is 1.25 ns/element)
+ * Input resets happen with the timer paused.
+ *
+ * Build: cmake -S . -B build && cmake --build build --target microbench_kernels
+ * Run:   ./build/microbench_kernels --benchmark_filter=Merge
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cstring>
+#include <cstdint>
+#include <functional>
+
+#include "../../../implementations/cpp/block_merge_segment_sort.h"
+#include "../../../implementations/cpp/SegmentSortIterator.h"
+
+namespace {
+
+    // --- Data ---
+
+    // Runs of |run_length| elements, ascending (> 0) or strictly descending
+    // (< 0); 0 is uniform random data
+    std::vector<int> make_runs(size_t n, long run_length) {
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> dis(0, 1 << 30);
+        std::vector<int> data(n);
+        if (run_length == 0) {
+            for (auto& x : data) x = dis(gen);
+            return data;
+        }
+        size_t len = static_cast<size_t>(run_length < 0 ? -run_length : run_length);
+        for (size_t start = 0; start < n; start += len) {
+            size_t end = std::min(n, start + len);
+            int base = dis(gen);
+            for (size_t i = start; i < end; ++i) {
+                int offset = static_cast<int>(i - start);
+                data[i] = run_length > 0 ? base + offset : base - offset;
+            }
+        }
+        return data;
+    }
+
+    // Two sorted halves [0, left) and [left, n) of random values
+    std::vector<int> make_halves(size_t n, size_t left) {
+        std::vector<int> data = make_runs(n, 0);
+        std::sort(data.begin(), data.begin() + left);
+        std::sort(data.begin() + left, data.end());
+        return data;
+    }
+
+    // Sorted 0..n-1 with every element moved at most ~k places (k-sorted);
+    // k = 0 is uniform random data
+    std::vector<int> make_ksorted(size_t n, size_t k) {
+        if (k == 0) return make_runs(n, 0);
+        std::mt19937 gen(42);
+        std::vector<int> data(n);
+        for (size_t i = 0; i < n; ++i) data[i] = static_cast<int>(i);
+        for (size_t i = 0; i + 1 < n; ++i) {
+            std::swap(data[i], data[std::min(n - 1, i + gen() % k)]);
+        }
+        return data;
+    }
+
+    void set_counters(benchmark::State& state, size_t n) {
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(n));
+        state.counters["time/elem"] = benchmark::Counter(
+            static_cast<double>(n),
+            benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    }
+
+    // --- Kernels ---
+
+    void BM_DetectSegment(benchmark::State& state) {
+        const size_t n = static_cast<size_t>(state.range(0));
+        const std::vector<int> original = make_runs(n, state.range(1));
+        std::vector<int> work = original;
+        std::less<int> comp;
+
+        for (auto _ : state) {
+            size_t runs = 0;
+            for (size_t i = 0; i < n; ++runs) {
+                i = segment_sort::detect_segment(work.data(), i, n, comp);
+            }
+            benchmark::DoNotOptimize(runs);
+            if (state.range(1) < 0) {
+                // Descending runs were reversed in place
+                state.PauseTiming();
+                std::memcpy(work.data(), original.data(), n * sizeof(int));
+                state.ResumeTiming();
+            }
+        }
+        set_counters(state, n);
+    }
+
+    // Both runs through the buffer, merged from both ends
+    void BM_MergeBidirectional(benchmark::State& state) {
+        const size_t n = static_cast<size_t>(state.range(0));
+        const size_t left = n * static_cast<size_t>(state.range(1)) / 100;
+        const std::vector<int> original = make_halves(n, left);
+        std::vector<int> work = original;
+        std::vector<int> buffer(n);
+        std::less<int> comp;
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            std::memcpy(work.data(), original.data(), n * sizeof(int));
+            state.ResumeTiming();
+            segment_sort::merge_bidirectional(work.data(), 0, left, n, buffer, comp);
+            benchmark::DoNotOptimize(work.data());
+            benchmark::ClobberMemory();
+        }
+        set_counters(state, n);
+    }
+
+    template<bool BufferLeft>
+    void BM_MergeWithBuffer(benchmark::State& state) {
+        const size_t n = static_cast<size_t>(state.range(0));
+        const size_t left = n * static_cast<size_t>(state.range(1)) / 100;
+        const std::vector<int> original = make_halves(n, left);
+        std::vector<int> work = original;
+        std::vector<int> buffer(n);
+        std::less<int> comp;
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            std::memcpy(work.data(), original.data(), n * sizeof(int));
+            state.ResumeTiming();
+            if (BufferLeft) {
+                segment_sort::merge_with_buffer_left(work.data(), 0, left, n, buffer, comp);
+            } else {
+                segment_sort::merge_with_buffer_right(work.data(), 0, left, n, buffer, comp);
+            }
+            benchmark::DoNotOptimize(work.data());
+            benchmark::ClobberMemory();
+        }
+        set_counters(state, n);
+    }
+
+    void BM_MergeWithBufferLeft(benchmark::State& state) { BM_MergeWithBuffer<true>(state); }
+    void BM_MergeWithBufferRight(benchmark::State& state) { BM_MergeWithBuffer<false>(state); }
+
+    // Same merges with an explicit prefetch distance (template argument of
+    // the kernels; the sort itself uses BLOCK_MERGE_PREFETCH_BYTES)
+    template<bool BufferLeft, size_t PrefetchBytes>
+    void BM_MergePrefetch(benchmark::State& state) {
+        const size_t n = static_cast<size_t>(state.range(0));
+        const size_t left = n / 2;
+        const std::vector<int> original = make_halves(n, left);
+        std::vector<int> work = original;
+        std::vector<int> buffer(n);
+        std::less<int> comp;
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            std::memcpy(work.data(), original.data(), n * sizeof(int));
+            state.ResumeTiming();
+            if (BufferLeft) {
+                segment_sort::merge_with_buffer_left<PrefetchBytes>(work.data(), 0, left, n, buffer, comp);
+            } else {
+                segment_sort::merge_with_buffer_right<PrefetchBytes>(work.data(), 0, left, n, buffer, comp);
+            }
+            benchmark::DoNotOptimize(work.data());
+            benchmark::ClobberMemory();
+        }
+        set_counters(state, n);
+    }
+
+    // 4096 random lookups per iteration into a sorted range of range(0)
+    // elements, as done by the SymMerge split; time/elem is per lookup
+    template<bool Branchless>
+    void BM_LowerBound(benchmark::State& state) {
+        const size_t n = static_cast<size_t>(state.range(0));
+        const size_t lookups = 4096;
+        std::vector<int> data = make_runs(n, 0);
+        std::sort(data.begin(), data.end());
+        const std::vector<int> keys = make_runs(lookups, 0);
+        std::less<int> comp;
+
+        for (auto _ : state) {
+            size_t sum = 0;
+            for (int key : keys) {
+                const int* it = Branchless
+                    ? segment_sort::branchless_lower_bound(data.data(), data.data() + n, key, comp)
+                    : std::lower_bound(data.data(), data.data() + n, key, comp);
+                sum += static_cast<size_t>(it - data.data());
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        set_counters(state, lookups);
+    }
+
+    // Rotation of [0, 40%, n): range(1) is the buffer limit of
+    // rotate_with_buffer (0 = Gries-Mills only); ignored by the others
+    enum RotateMethod { ROTATE_STD, ROTATE_REVERSAL, ROTATE_BUFFER };
+
+    template<RotateMethod Method>
+    void BM_Rotate(benchmark::State& state) {
+        const size_t n = static_cast<size_t>(state.range(0));
+        const size_t buffer_limit = static_cast<size_t>(state.range(1));
+        const size_t middle = n * 2 / 5;
+        std::vector<int> work = make_runs(n, 0);
+        std::vector<int> buffer;
+        buffer.reserve(buffer_limit);
+
+        for (auto _ : state) {
+            switch (Method) {
+                case ROTATE_STD:
+                    std::rotate(work.begin(), work.begin() + middle, work.end());
+                    break;
+                case ROTATE_REVERSAL:
+                    std::reverse(work.begin(), work.begin() + middle);
+                    std::reverse(work.begin() + middle, work.end());
+                    std::reverse(work.begin(), work.end());
+                    break;
+                case ROTATE_BUFFER:
+                    segment_sort::rotate_with_buffer(work.data(), 0, middle, n, buffer, buffer_limit);
+                    break;
+            }
+            benchmark::DoNotOptimize(work.data());
+            benchmark::ClobberMemory();
+        }
+        set_counters(state, n);
+    }
+
+    // buffered_merge with a buffer far smaller than both halves (range(1) =
+    // buffer): InPlaceBlockMerge = false measures the SymMerge rotation path
+    // down to buffer-sized leaves, true the in-place block merge
+    template<bool InPlaceBlockMerge>
+    void BM_SmallBufferMerge(benchmark::State& state) {
+        const size_t n = static_cast<size_t>(state.range(0));
+        const size_t buffer_limit = static_cast<size_t>(state.range(1));
+        const std::vector<int> original = make_halves(n, n / 2);
+        std::vector<int> work = original;
+        std::vector<int> buffer;
+        buffer.reserve(buffer_limit);
+        std::less<int> comp;
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            std::memcpy(work.data(), original.data(), n * sizeof(int));
+            state.ResumeTiming();
+            segment_sort::buffered_merge<InPlaceBlockMerge>(work.data(), 0, n / 2, n, buffer, buffer_limit, comp);
+            benchmark::DoNotOptimize(work.data());
+            benchmark::ClobberMemory();
+        }
+        set_counters(state, n);
+    }
+
+    // The merge phase of a sort: runs of 32 are presorted (not timed), then
+    // bottom-up passes merge them with buffered_merge and a 64K buffer.
+    // Bidirectional = false forces the forward-only merges (range(1) = k,
+    // 0 = random)
+    template<bool Bidirectional>
+    void BM_MergePasses(benchmark::State& state) {
+        const size_t n = static_cast<size_t>(state.range(0));
+        std::vector<int> original = make_ksorted(n, static_cast<size_t>(state.range(1)));
+        const size_t run = 32;
+        for (size_t i = 0; i < n; i += run) {
+            std::sort(original.begin() + i, original.begin() + std::min(n, i + run));
+        }
+        std::vector<int> work = original;
+        std::vector<int> buffer;
+        buffer.reserve(BLOCK_MERGE_DEFAULT_BUFFER_SIZE);
+        std::less<int> comp;
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            std::memcpy(work.data(), original.data(), n * sizeof(int));
+            state.ResumeTiming();
+            for (size_t width = run; width < n; width *= 2) {
+                for (size_t first = 0; first + width < n; first += 2 * width) {
+                    segment_sort::buffered_merge<true, Bidirectional>(work.data(), first, first + width,
+                        std::min(n, first + 2 * width), buffer, BLOCK_MERGE_DEFAULT_BUFFER_SIZE, comp);
+                }
+            }
+            benchmark::DoNotOptimize(work.data());
+            benchmark::ClobberMemory();
+        }
+        set_counters(state, n);
+    }
+
+    // Iterator::next() over a full drain; heap construction is not timed
+    void BM_IteratorNext(benchmark::State& state) {
+        const size_t n = static_cast<size_t>(state.range(0));
+        const std::vector<int> data = make_runs(n, state.range(1));
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            SegmentSort::Iterator<int> iter(data);
+            state.ResumeTiming();
+            int64_t sum = 0;
+            while (iter.hasNext()) sum += iter.next();
+            benchmark::DoNotOptimize(sum);
+        }
+        set_counters(state, n);
+    }
+
+} // namespace
+
+// Sizes: in L1/L2, in L3, beyond L3 on most machines
+BENCHMARK(BM_DetectSegment)
+    ->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, {0, 16, 256, 4096, -16, -4096}});
+BENCHMARK(BM_MergeWithBufferLeft)
+    ->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, {50, 25, 10}});
+BENCHMARK(BM_MergeWithBufferRight)
+    ->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, {50, 90}});
+BENCHMARK(BM_MergeBidirectional)
+    ->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, {50, 25, 10}});
+BENCHMARK_TEMPLATE(BM_MergePrefetch, true, 0)->Arg(1 << 20)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_MergePrefetch, true, 256)->Arg(1 << 20)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_MergePrefetch, true, 512)->Arg(1 << 20)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_MergePrefetch, true, 2048)->Arg(1 << 20)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_MergePrefetch, false, 0)->Arg(1 << 20)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_MergePrefetch, false, 256)->Arg(1 << 20)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_MergePrefetch, false, 512)->Arg(1 << 20)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_MergePrefetch, false, 2048)->Arg(1 << 20)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_LowerBound, false)->Arg(1 << 16)->Arg(1 << 20)->Arg(1 << 26);
+BENCHMARK_TEMPLATE(BM_LowerBound, true)->Arg(1 << 16)->Arg(1 << 20)->Arg(1 << 26);
+BENCHMARK_TEMPLATE(BM_Rotate, ROTATE_STD)->Args({1 << 16, 0})->Args({1 << 20, 0})->Args({1 << 24, 0});
+BENCHMARK_TEMPLATE(BM_Rotate, ROTATE_REVERSAL)->Args({1 << 16, 0})->Args({1 << 20, 0})->Args({1 << 24, 0});
+BENCHMARK_TEMPLATE(BM_Rotate, ROTATE_BUFFER)
+    ->ArgsProduct({{1 << 16, 1 << 20, 1 << 24}, {0, 4096, 65536}})->Args({1 << 24, 1 << 23});
+BENCHMARK_TEMPLATE(BM_SmallBufferMerge, false)
+    ->ArgsProduct({{1 << 16, 1 << 20, 1 << 22}, {64, 512, 1024, 4096, 16384}});
+BENCHMARK_TEMPLATE(BM_SmallBufferMerge, true)
+    ->ArgsProduct({{1 << 16, 1 << 20, 1 << 22}, {64, 512, 1024, 4096, 16384}});
+BENCHMARK_TEMPLATE(BM_MergePasses, false)
+    ->ArgsProduct({{1 << 16, 1 << 20}, {0, 16, 1024}});
+BENCHMARK_TEMPLATE(BM_MergePasses, true)
+    ->ArgsProduct({{1 << 16, 1 << 20}, {0, 16, 1024}});
+BENCHMARK(BM_IteratorNext)
+    ->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {16, 256, 4096}});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,225 @@
+/**
+ * Hardware Performance Counters for C++ Benchmarks
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Thin perf_event_open(2) wrapper that counts, for the calling thread and
+ * user space only:
+ *   cycles, instructions, branch misses, L1d read misses, LLC read misses,
+ *   dTLB read misses.
+ *
+ * Events are opened as two groups, {cycles, instructions, branch misses}
+ * and {L1d, LLC, dTLB misses}. The kernel schedules a group all or nothing,
+ * and one group of six would need every counter of a typical PMU (2 fixed
+ * + 4 general on Intel, 6 general on AMD): it would never run while the
+ * NMI watchdog holds one. Each group is read atomically and scaled by its
+ * own enabled/running times when the kernel multiplexes them; a group that
+ * never ran reports its counters as invalid. Events the CPU/kernel does
+ * not support are skipped;
+ * if none can be opened (non-Linux, containers, VMs without a PMU,
+ * perf_event_paranoid > 2) available() returns false and callers fall back
+ * to wall-clock timing only.
+ *
+ * Usage:
+ *   perf::CounterGroup counters;
+ *   counters.start();
+ *   sort(...);
+ *   perf::CounterValues v = counters.stop();
+ *   if (v.valid[perf::CYCLES]) ...
+ */
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace perf {
+
+    enum Counter {
+        CYCLES = 0,
+        INSTRUCTIONS,
+        BRANCH_MISSES,
+        L1D_MISSES,
+        LLC_MISSES,
+        DTLB_MISSES,
+        NUM_COUNTERS
+    };
+
+    // JSON / console names, indexed by Counter
+    inline const char* counterName(int counter) {
+        static const char* names[NUM_COUNTERS] = {
+            "cycles", "instructions", "branchMisses", "l1dMisses", "llcMisses", "dtlbMisses"
+        };
+        return names[counter];
+    }
+
+    struct CounterValues {
+        uint64_t values[NUM_COUNTERS] = {};
+        bool valid[NUM_COUNTERS] = {};
+
+        bool any() const {
+            for (int i = 0; i < NUM_COUNTERS; ++i) {
+                if (valid[i]) return true;
+            }
+            return false;
+        }
+    };
+
+    // Median of one counter over several runs (ignores invalid runs)
+    inline double medianCounter(const std::vector<CounterValues>& runs, int counter) {
+        std::vector<double> v;
+        for (const auto& r : runs) {
+            if (r.valid[counter]) v.push_back(static_cast<double>(r.values[counter]));
+        }
+        if (v.empty()) return 0.0;
+        std::sort(v.begin(), v.end());
+        size_t n = v.size();
+        return (n % 2 == 1) ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2.0;
+    }
+
+#ifdef __linux__
+
+    class CounterGroup {
+    private:
+        // Events of one perf group share a leader and are scheduled together
+        static constexpr int NUM_GROUPS = 2;
+        static constexpr int group_of[NUM_COUNTERS] = {0, 0, 0, 1, 1, 1};
+
+        int fds[NUM_COUNTERS];
+        uint64_t ids[NUM_COUNTERS];
+        int leaders[NUM_GROUPS] = {-1, -1};
+
+        static int openEvent(uint32_t type, uint64_t config, int group_fd) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = (group_fd == -1) ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID |
+                               PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+        }
+
+        static uint64_t cacheConfig(uint64_t cache, uint64_t op, uint64_t result) {
+            return cache | (op << 8) | (result << 16);
+        }
+
+        // Reads one group and stores its scaled values into result
+        void readGroup(int group, CounterValues& result) const {
+            // Layout: nr, time_enabled, time_running, {value, id} * nr
+            uint64_t buf[3 + 2 * NUM_COUNTERS];
+            ssize_t bytes = read(fds[leaders[group]], buf, sizeof(buf));
+            if (bytes < static_cast<ssize_t>(3 * sizeof(uint64_t))) return;
+
+            uint64_t nr = buf[0];
+            uint64_t enabled = buf[1];
+            uint64_t running = buf[2];
+            if (running == 0) return; // Group never scheduled on the PMU
+            double scale = static_cast<double>(enabled) / static_cast<double>(running);
+
+            for (uint64_t k = 0; k < nr && k < NUM_COUNTERS; ++k) {
+                uint64_t value = buf[3 + 2 * k];
+                uint64_t id = buf[4 + 2 * k];
+                for (int i = 0; i < NUM_COUNTERS; ++i) {
+                    if (fds[i] >= 0 && group_of[i] == group && ids[i] == id) {
+                        result.values[i] = static_cast<uint64_t>(value * scale);
+                        result.valid[i] = true;
+                    }
+                }
+            }
+        }
+
+    public:
+        CounterGroup() {
+            const uint32_t types[NUM_COUNTERS] = {
+                PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+                PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE
+            };
+            const uint64_t configs[NUM_COUNTERS] = {
+                PERF_COUNT_HW_CPU_CYCLES,
+                PERF_COUNT_HW_INSTRUCTIONS,
+                PERF_COUNT_HW_BRANCH_MISSES,
+                cacheConfig(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS),
+                cacheConfig(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS),
+                cacheConfig(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)
+            };
+
+            for (int i = 0; i < NUM_COUNTERS; ++i) {
+                int& leader = leaders[group_of[i]];
+                fds[i] = openEvent(types[i], configs[i], leader == -1 ? -1 : fds[leader]);
+                ids[i] = 0;
+                if (fds[i] < 0) continue;
+                if (leader == -1) leader = i;
+                if (ioctl(fds[i], PERF_EVENT_IOC_ID, &ids[i]) < 0) {
+                    // A failed leader takes no members yet: the next event leads
+                    close(fds[i]);
+                    fds[i] = -1;
+                    if (leader == i) leader = -1;
+                }
+            }
+        }
+
+        ~CounterGroup() {
+            for (int i = 0; i < NUM_COUNTERS; ++i) {
+                if (fds[i] >= 0) close(fds[i]);
+            }
+        }
+
+        CounterGroup(const CounterGroup&) = delete;
+        CounterGroup& operator=(const CounterGroup&) = delete;
+
+        bool available() const {
+            for (int g = 0; g < NUM_GROUPS; ++g) {
+                if (leaders[g] != -1) return true;
+            }
+            return false;
+        }
+
+        void start() {
+            for (int g = 0; g < NUM_GROUPS; ++g) {
+                if (leaders[g] == -1) continue;
+                ioctl(fds[leaders[g]], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ioctl(fds[leaders[g]], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+        }
+
+        CounterValues stop() {
+            CounterValues result;
+            for (int g = 0; g < NUM_GROUPS; ++g) {
+                if (leaders[g] != -1) ioctl(fds[leaders[g]], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            }
+            for (int g = 0; g < NUM_GROUPS; ++g) {
+                if (leaders[g] != -1) readGroup(g, result);
+            }
+            return result;
+        }
+    };
+
+#else
+
+    // Non-Linux: counters are never available, benchmarks report wall time only
+    class CounterGroup {
+    public:
+        bool available() const { return false; }
+        void start() {}
+        CounterValues stop() { return CounterValues(); }
+    };
+
+#endif
+
+} // namespace perf
+
+#endif // PERF_COUNTERS_H
@@ -4,7 +4,9 @@
 #define MERGESORTS_POWERSORT_H
 
 #include <cassert>
-#include "../algorithms.h"
+#include <cmath>
+#include <string>
+#include "algorithms.h"
 #include "insertionsort.h"
 #include "merging.h"
 #include <vector>
@@ -24,7 +26,7 @@ namespace algorithms {
 		BITWISE_LOOP,
 		MOST_SIGNIFICANT_SET_BIT,
 	};
-	std::string to_string(node_power_implementations implementation) {
+	inline std::string to_string(node_power_implementations implementation) {
 		switch (implementation) {
 			case TRIVIAL: return "TRIVIAL";
 			case DIVISION_LOOP: return "DIVISION_LOOP";
@@ -36,7 +38,7 @@ namespace algorithms {
 	};
 
 
-	power_t node_power_trivial(size_t begin, size_t end,
+	inline power_t node_power_trivial(size_t begin, size_t end,
 	                            size_t beginA, size_t beginB, size_t endB) {
 		size_t n = end - begin;
 		size_t n1 = beginB - beginA, n2 = endB - beginB;
@@ -51,7 +53,7 @@ namespace algorithms {
 		return k;
 	}
 
-    power_t node_power_div(size_t begin, size_t end,
+    inline power_t node_power_div(size_t begin, size_t end,
 	                        size_t beginA, size_t beginB, size_t endB) {
 		size_t twoN = 2*(end - begin); // 2*n
 		size_t n1 = beginB - beginA, n2 = endB - beginB; // lengths of runs
@@ -66,10 +68,10 @@ namespace algorithms {
 		return k;
 	}
 
-    power_t node_power_bitwise(size_t begin, size_t end,
+    inline power_t node_power_bitwise(size_t begin, size_t end,
 	                            size_t beginA, size_t beginB, size_t endB) {
 		size_t n = end - begin;
-		assert (n < (1L << 63));
+		assert (n < (1UL << 63));
 		size_t l = beginA - begin + beginB - begin;
 		size_t r = beginB - begin + endB - begin;
 		// a and b are given by l/(2*n) and r/(2*n), both are in [0,1).
@@ -87,7 +89,7 @@ namespace algorithms {
 		return nCommonBits + 1;
 	}
 
-    power_t node_power_clz(size_t begin, size_t end,
+    inline power_t node_power_clz(size_t begin, size_t end,
 	                        size_t beginA, size_t beginB, size_t endB) {
 		size_t n = end - begin;
 		assert(n <= (1L << 31));
@@ -99,11 +101,11 @@ namespace algorithms {
 	}
 
 	// not precise enough for large powers ...
-    power_t node_power_clz_unconstrained(ptrdiff_t begin, ptrdiff_t end,
+    inline power_t node_power_clz_unconstrained(ptrdiff_t begin, ptrdiff_t end,
 	                                      ptrdiff_t beginA, ptrdiff_t beginB, ptrdiff_t endB) {
 		assert(begin <= beginA && beginA <= beginB && beginB <= endB && endB <= end);
 		auto n = static_cast<size_t>(end - begin);
-		assert(n < (1L << 63));
+		assert(n < (1UL << 63));
 		auto l2 = static_cast<size_t>((beginA - begin) + (beginB - begin)); // 2*l
 		auto r2 = static_cast<size_t>((beginB - begin) + (endB - begin));   // 2*r
 		static_assert(sizeof(size_t) == 8, "assume 64bit size_t"); // can compute with 64 bits
@@ -128,12 +130,12 @@ namespace algorithms {
 		}
 	}
 
-	unsigned floor_log2(unsigned int n) {
+	inline unsigned floor_log2(unsigned int n) {
 		if (n <= 0) return 0;
 		return 31 - __builtin_clz( n );
 	}
 
-	unsigned floor_log2(unsigned long n) {
+	inline unsigned floor_log2(unsigned long n) {
 		if (n <= 0) return 0;
 		return 63 - __builtin_clzl( n );
 	}
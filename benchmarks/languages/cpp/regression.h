@@ -0,0 +1,314 @@
+/**
+ * Regression Tracking for C++ Benchmarks
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Reads a baseline results JSON and compares fresh timings against it:
+ * - Minimal JSON reader (objects, arrays, strings, numbers, literals)
+ * - Baseline extraction tolerant to the schemas in benchmarks/results/
+ *   (C, JS, Python and C++ runs): entries need "algorithm", "size" and
+ *   "dataType", plus "allTimes" (preferred) or "statistics.median".
+ *   Failed or empty entries are skipped.
+ * - Percentile bootstrap CI of the median ratio (current / baseline)
+ *
+ * A comparison is a regression only when the whole 95% CI lies above
+ * 1 + threshold, so a noisy machine does not fail the gate on its own.
+ */
+
+#ifndef REGRESSION_H
+#define REGRESSION_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <random>
+#include <cstdlib>
+#include <cstdint>
+
+namespace regression {
+
+    // --- Minimal JSON reader ---
+
+    struct JsonValue {
+        enum Type { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT } type = NUL;
+        bool boolean = false;
+        double number = 0.0;
+        std::string string;
+        std::vector<JsonValue> array;
+        std::map<std::string, JsonValue> object;
+
+        const JsonValue* get(const std::string& key) const {
+            if (type != OBJECT) return nullptr;
+            auto it = object.find(key);
+            return it == object.end() ? nullptr : &it->second;
+        }
+    };
+
+    class JsonParser {
+    private:
+        const std::string& text;
+        size_t pos = 0;
+
+        void skipWhitespace() {
+            while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\n' || text[pos] == '\r' || text[pos] == '\t')) {
+                pos++;
+            }
+        }
+
+        bool consume(const char* literal) {
+            size_t len = std::char_traits<char>::length(literal);
+            if (text.compare(pos, len, literal) != 0) return false;
+            pos += len;
+            return true;
+        }
+
+        bool parseString(std::string& out) {
+            if (text[pos] != '"') return false;
+            pos++;
+            while (pos < text.size() && text[pos] != '"') {
+                char c = text[pos++];
+                if (c == '\\' && pos < text.size()) {
+                    char e = text[pos++];
+                    switch (e) {
+                        case 'n': out += '\n'; break;
+                        case 't': out += '\t'; break;
+                        case 'r': out += '\r'; break;
+                        case 'b': out += '\b'; break;
+                        case 'f': out += '\f'; break;
+                        case 'u': out += '?'; pos += 4; break; // Names are ASCII; keep position right
+                        default: out += e; break;
+                    }
+                } else {
+                    out += c;
+                }
+            }
+            if (pos >= text.size()) return false;
+            pos++;
+            return true;
+        }
+
+        bool parseValue(JsonValue& value) {
+            skipWhitespace();
+            if (pos >= text.size()) return false;
+            char c = text[pos];
+            if (c == '{') {
+                value.type = JsonValue::OBJECT;
+                pos++;
+                skipWhitespace();
+                if (pos < text.size() && text[pos] == '}') { pos++; return true; }
+                while (true) {
+                    skipWhitespace();
+                    std::string key;
+                    if (pos >= text.size() || !parseString(key)) return false;
+                    skipWhitespace();
+                    if (pos >= text.size() || text[pos] != ':') return false;
+                    pos++;
+                    if (!parseValue(value.object[key])) return false;
+                    skipWhitespace();
+                    if (pos < text.size() && text[pos] == ',') { pos++; continue; }
+                    if (pos < text.size() && text[pos] == '}') { pos++; return true; }
+                    return false;
+                }
+            }
+            if (c == '[') {
+                value.type = JsonValue::ARRAY;
+                pos++;
+                skipWhitespace();
+                if (pos < text.size() && text[pos] == ']') { pos++; return true; }
+                while (true) {
+                    value.array.emplace_back();
+                    if (!parseValue(value.array.back())) return false;
+                    skipWhitespace();
+                    if (pos < text.size() && text[pos] == ',') { pos++; continue; }
+                    if (pos < text.size() && text[pos] == ']') { pos++; return true; }
+                    return false;
+                }
+            }
+            if (c == '"') {
+                value.type = JsonValue::STRING;
+                return parseString(value.string);
+            }
+            if (consume("true")) { value.type = JsonValue::BOOL; value.boolean = true; return true; }
+            if (consume("false")) { value.type = JsonValue::BOOL; return true; }
+            if (consume("null")) { value.type = JsonValue::NUL; return true; }
+
+            // Number (also accepts the nan/inf some runs wrote)
+            const char* start = text.c_str() + pos;
+            char* end = nullptr;
+            value.number = std::strtod(start, &end);
+            if (end == start) return false;
+            value.type = JsonValue::NUMBER;
+            pos += static_cast<size_t>(end - start);
+            return true;
+        }
+
+    public:
+        explicit JsonParser(const std::string& input) : text(input) {}
+
+        bool parse(JsonValue& root) {
+            if (!parseValue(root)) return false;
+            skipWhitespace();
+            return pos == text.size();
+        }
+    };
+
+    // --- Baseline ---
+
+    struct BaselineEntry {
+        std::string algorithm;
+        std::string dataType;
+        size_t size = 0;
+        std::vector<double> times; // Empty if only the median was recorded
+        double median = 0.0;
+    };
+
+    struct Baseline {
+        std::vector<BaselineEntry> entries;
+        std::vector<size_t> sizes;  // In order of first appearance
+        bool has_seed = false;
+        uint64_t seed = 0;
+        std::string datasets;       // "datasets" metadata of cpp_benchmarks runs
+    };
+
+    inline double medianOf(std::vector<double> values) {
+        if (values.empty()) return 0.0;
+        std::sort(values.begin(), values.end());
+        size_t n = values.size();
+        return (n % 2 == 1) ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2.0;
+    }
+
+    // Returns an empty string on success, otherwise the error
+    inline std::string loadBaseline(const std::string& path, Baseline& baseline) {
+        std::ifstream file(path);
+        if (!file) return "no se pudo abrir " + path;
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        std::string text = buffer.str();
+
+        JsonValue root;
+        JsonParser parser(text);
+        if (!parser.parse(root)) return "JSON invalido en " + path;
+
+        if (const JsonValue* metadata = root.get("metadata")) {
+            const JsonValue* seed = metadata->get("seed");
+            if (seed && seed->type == JsonValue::NUMBER) {
+                baseline.has_seed = true;
+                baseline.seed = static_cast<uint64_t>(seed->number);
+            }
+            const JsonValue* datasets = metadata->get("datasets");
+            if (datasets && datasets->type == JsonValue::STRING) baseline.datasets = datasets->string;
+        }
+
+        const JsonValue* results = root.get("results");
+        if (!results || results->type != JsonValue::ARRAY) return "sin array \"results\" en " + path;
+
+        for (const JsonValue& r : results->array) {
+            const JsonValue* algorithm = r.get("algorithm");
+            const JsonValue* size = r.get("size");
+            const JsonValue* dataType = r.get("dataType");
+            if (!algorithm || algorithm->type != JsonValue::STRING) continue;
+            if (!size || size->type != JsonValue::NUMBER) continue;
+            if (!dataType || dataType->type != JsonValue::STRING) continue;
+            // Only the int32 matrix is rerun; type matrix entries are skipped
+            const JsonValue* elementType = r.get("elementType");
+            if (elementType && elementType->type == JsonValue::STRING && elementType->string != "int32") continue;
+            const JsonValue* success = r.get("success");
+            if (success && success->type == JsonValue::BOOL && !success->boolean) continue;
+
+            BaselineEntry entry;
+            entry.algorithm = algorithm->string;
+            entry.dataType = dataType->string;
+            entry.size = static_cast<size_t>(size->number);
+
+            const JsonValue* times = r.get("allTimes");
+            if (!times) times = r.get("times");
+            if (times && times->type == JsonValue::ARRAY) {
+                for (const JsonValue& t : times->array) {
+                    if (t.type == JsonValue::NUMBER && t.number > 0) entry.times.push_back(t.number);
+                }
+            }
+            if (!entry.times.empty()) {
+                entry.median = medianOf(entry.times);
+            } else if (const JsonValue* stats = r.get("statistics")) {
+                const JsonValue* median = stats->get("median");
+                if (median && median->type == JsonValue::NUMBER) entry.median = median->number;
+            }
+            if (entry.median <= 0) continue;
+
+            if (std::find(baseline.sizes.begin(), baseline.sizes.end(), entry.size) == baseline.sizes.end()) {
+                baseline.sizes.push_back(entry.size);
+            }
+            baseline.entries.push_back(entry);
+        }
+
+        if (baseline.entries.empty()) return "ningun resultado utilizable en " + path;
+        return "";
+    }
+
+    // --- Comparison ---
+
+    struct Comparison {
+        double baseline_median = 0.0;
+        double current_median = 0.0;
+        double ratio = 1.0;   // current / baseline
+        double ci_low = 1.0;  // 95% bootstrap CI of the ratio
+        double ci_high = 1.0;
+        bool regression = false;
+        bool improvement = false;
+    };
+
+    // Percentile bootstrap of median(current) / median(baseline). Each side is
+    // resampled independently; a baseline with only a median stays fixed.
+    inline Comparison compare(const BaselineEntry& base, const std::vector<double>& current,
+                              double threshold, int iterations = 2000) {
+        Comparison c;
+        c.baseline_median = base.median;
+        c.current_median = medianOf(current);
+        c.ratio = c.current_median / c.baseline_median;
+
+        std::mt19937 gen(20261018);
+        std::vector<double> ratios;
+        ratios.reserve(iterations);
+        std::vector<double> sample_base(base.times.size());
+        std::vector<double> sample_cur(current.size());
+        for (int it = 0; it < iterations && !current.empty(); ++it) {
+            double base_median = base.median;
+            if (!base.times.empty()) {
+                std::uniform_int_distribution<size_t> pick(0, base.times.size() - 1);
+                for (auto& x : sample_base) x = base.times[pick(gen)];
+                base_median = medianOf(sample_base);
+            }
+            std::uniform_int_distribution<size_t> pick(0, current.size() - 1);
+            for (auto& x : sample_cur) x = current[pick(gen)];
+            ratios.push_back(medianOf(sample_cur) / base_median);
+        }
+        if (!ratios.empty()) {
+            std::sort(ratios.begin(), ratios.end());
+            c.ci_low = ratios[static_cast<size_t>(0.025 * (ratios.size() - 1))];
+            c.ci_high = ratios[static_cast<size_t>(0.975 * (ratios.size() - 1))];
+        }
+
+        c.regression = c.ci_low > 1.0 + threshold;
+        c.improvement = c.ci_high < 1.0 - threshold;
+        return c;
+    }
+
+    // "3%", "3" -> 0.03; "0.03" -> 0.03. Returns a negative value on error.
+    inline double parseThreshold(const std::string& text) {
+        std::string number = text;
+        bool percent = !number.empty() && number.back() == '%';
+        if (percent) number.pop_back();
+        char* end = nullptr;
+        double value = std::strtod(number.c_str(), &end);
+        if (number.empty() || *end != '\0' || value < 0) return -1.0;
+        if (percent || value >= 1.0) value /= 100.0;
+        return value;
+    }
+
+} // namespace regression
+
+#endif // REGRESSION_H
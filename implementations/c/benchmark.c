@@ -72,6 +72,19 @@ void fill_nearly_sorted(int* arr, size_t n) {
     }
 }
 
+// Every element at most ~K_SORTED_DISTANCE places from its sorted position
+#define K_SORTED_DISTANCE 1024
+void fill_k_sorted(int* arr, size_t n) {
+    fill_sorted(arr, n);
+    for (size_t i = 0; i + 1 < n; i++) {
+        size_t j = i + (size_t)rand() % K_SORTED_DISTANCE;
+        if (j >= n) j = n - 1;
+        int tmp = arr[i];
+        arr[i] = arr[j];
+        arr[j] = tmp;
+    }
+}
+
 void fill_duplicates(int* arr, size_t n) {
     for (size_t i = 0; i < n; i++) arr[i] = rand() % 20; // Only 20 unique values
 }
@@ -161,6 +174,17 @@ void run_single_benchmark(const char* type_name, void (*fill_func)(int*, size_t)
         printf("\033[1;31mx%.2f Slower\033[0m\n", avg_block / avg_q);
     }
 
+#if defined(USE_V3) && defined(SEGMENT_SORT_STATS)
+    // Internal counters from one extra, untimed run
+    SortStats stats;
+    memcpy(arr_copy, arr_orig, n * sizeof(int));
+    block_merge_segment_sort_with_stats(arr_copy, n, &stats);
+    printf("    stats: cmp/elem %.2f | moves/elem %.2f | runs %zu | buffer %llu | symmerge %llu | depth %zu | stack %zu\n",
+           (double)stats.comparisons / n, (double)stats.moves / n, stats.runs,
+           (unsigned long long)stats.buffer_merges, (unsigned long long)stats.symmerge_splits,
+           stats.max_recursion_depth, stats.max_stack_depth);
+#endif
+
     free(arr_orig);
     free(arr_copy);
 }
@@ -183,6 +207,7 @@ int main(int argc, char* argv[]) {
     run_single_benchmark("Sorted", fill_sorted, size);
     run_single_benchmark("Reverse", fill_reverse, size);
     run_single_benchmark("Nearly Sorted", fill_nearly_sorted, size);
+    run_single_benchmark("K-Sorted", fill_k_sorted, size);
     run_single_benchmark("Duplicates", fill_duplicates, size);
 
     printf("==================================================================================\n\n");
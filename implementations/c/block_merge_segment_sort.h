@@ -107,6 +107,56 @@ static void bm_rotate_range(int* arr, size_t first, size_t middle, size_t last)
     bm_reverse_slice(arr, first, last);
 }
 
+// Helper: Swap [a, a + len) with [b, b + len) (non-overlapping)
+static void bm_swap_ranges(int* arr, size_t a, size_t b, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        int temp = arr[a + i];
+        arr[a + i] = arr[b + i];
+        arr[b + i] = temp;
+    }
+}
+
+// Helper: Rotate using the merge buffer. If the shorter side fits: memcpy it
+// out, memmove the longer side, memcpy it back. Otherwise Gries-Mills block
+// swaps (each swap puts the shorter side in its final place) until the
+// remaining shorter side fits. Without a buffer: triple reversal.
+// Returns the number of element moves.
+static size_t bm_rotate_with_buffer(int* arr, size_t first, size_t middle, size_t last, int* buffer, size_t buffer_size) {
+    size_t moves = 0;
+    if (buffer_size == 0) {
+        bm_rotate_range(arr, first, middle, last);
+        return 2 * (last - first);
+    }
+    while (first < middle && middle < last) {
+        size_t len1 = middle - first;
+        size_t len2 = last - middle;
+        if (len1 <= len2 && len1 <= buffer_size) {
+            memcpy(buffer, &arr[first], len1 * sizeof(int));
+            memmove(&arr[first], &arr[middle], len2 * sizeof(int));
+            memcpy(&arr[first + len2], buffer, len1 * sizeof(int));
+            return moves + 2 * len1 + len2;
+        }
+        if (len2 < len1 && len2 <= buffer_size) {
+            memcpy(buffer, &arr[middle], len2 * sizeof(int));
+            memmove(&arr[first + len2], &arr[first], len1 * sizeof(int));
+            memcpy(&arr[first], buffer, len2 * sizeof(int));
+            return moves + len1 + 2 * len2;
+        }
+        if (len1 <= len2) {
+            bm_swap_ranges(arr, first, middle, len1);  // A B1 B2 -> B1 A B2
+            moves += 2 * len1;
+            first = middle;
+            middle += len1;
+        } else {
+            bm_swap_ranges(arr, middle - len2, middle, len2);  // A1 A2 B -> A1 B A2
+            moves += 2 * len2;
+            last = middle;
+            middle -= len2;
+        }
+    }
+    return moves;
+}
+
 // Helper: Merge with Buffer (Left optimization)
 static void bm_merge_with_buffer_left(int* arr, size_t first, size_t middle, size_t last, int* buffer) {
     size_t len1 = middle - first;
@@ -186,7 +236,7 @@ static void bm_buffered_merge(int* arr, size_t first, size_t middle, size_t last
     
     size_t newMid = mid1 + (mid2 - middle);
     
-    bm_rotate_range(arr, mid1, middle, mid2);
+    bm_rotate_with_buffer(arr, mid1, middle, mid2, buffer, buffer_size);
     
     bm_buffered_merge(arr, first, mid1, newMid, buffer, buffer_size);
     bm_buffered_merge(arr, newMid + 1, mid2, last, buffer, buffer_size);
@@ -16,11 +16,52 @@
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
+#include <stdint.h>
 
 // Fixed buffer size for optimal performance (fits in L2 cache).
 // 64K elements = 256KB for int arrays
 #define BLOCK_MERGE_DEFAULT_BUFFER_SIZE 65536
 
+// Number of log2 buckets in the run-length histogram
+#define SORT_STATS_HISTOGRAM_BUCKETS 64
+
+// Merges whose runs both fit in the buffer (neither below a quarter of the
+// merge) go through bm_merge_bidirectional. -DSEGMENT_SORT_BIDIRECTIONAL_MERGE=0
+// keeps the forward/backward merges only.
+#ifndef SEGMENT_SORT_BIDIRECTIONAL_MERGE
+#define SEGMENT_SORT_BIDIRECTIONAL_MERGE 1
+#endif
+
+/**
+ * Counters filled by block_merge_segment_sort_with_stats when the header is
+ * compiled with -DSEGMENT_SORT_STATS (same fields as segment_sort::SortStats
+ * in the C++ implementation). Without the flag every counter expands to
+ * nothing and the struct is only zeroed.
+ */
+typedef struct {
+    uint64_t comparisons;      // Element comparisons
+    uint64_t moves;            // Element copies/moves (buffer, merge, rotate, reverse)
+    uint64_t buffer_merges;    // Linear merges through the buffer
+    uint64_t symmerge_splits;  // SymMerge fallbacks (both sides larger than the buffer)
+    uint64_t skipped_merges;   // Merges skipped because the runs were already in order
+    uint64_t rotations;        // Rotations performed by SymMerge
+    uint64_t rotated_elements; // Sum of rotation lengths
+    size_t max_rotation;       // Longest single rotation
+    size_t max_recursion_depth; // Deepest SymMerge recursion
+    size_t max_stack_depth;    // Deepest run stack
+    size_t runs;               // Natural runs detected
+    // run_length_histogram[k] = natural runs with length in [2^k, 2^(k+1))
+    uint64_t run_length_histogram[SORT_STATS_HISTOGRAM_BUCKETS];
+} SortStats;
+
+#ifdef SEGMENT_SORT_STATS
+#define BM_STAT(stats, statement) do { if (stats) { statement; } } while (0)
+#define BM_CMP(stats, expr) ((stats) ? (void)(stats)->comparisons++ : (void)0, (expr))
+#else
+#define BM_STAT(stats, statement) ((void)(stats))
+#define BM_CMP(stats, expr) (expr)
+#endif
+
 // Helper: Reverse a slice of the array
 static void bm_reverse_slice(int* arr, size_t start, size_t end) {
     size_t i = start;
@@ -34,9 +75,18 @@ static void bm_reverse_slice(int* arr, size_t start, size_t end) {
     }
 }
 
+#ifdef SEGMENT_SORT_STATS
+// Helper: floor(log2(x)) for x >= 1 (histogram bucket)
+static size_t bm_log2_bucket(size_t x) {
+    size_t k = 0;
+    while (x >>= 1) k++;
+    return k;
+}
+#endif
+
 // Helper: Detect a sorted segment (run)
 // Optimized: Groups consecutive duplicates first to reduce merge overhead
-static size_t bm_detect_segment(int* arr, size_t start, size_t n) {
+static size_t bm_detect_segment(int* arr, size_t start, size_t n, SortStats* stats) {
     if (start >= n) return start;
     
     size_t end = start + 1;
@@ -44,21 +94,22 @@ static size_t bm_detect_segment(int* arr, size_t start, size_t n) {
 
     // First group all consecutive duplicates to avoid small runs
     const int current_val = arr[start];
-    while (end < n && arr[end] == current_val) {
+    while (end < n && BM_CMP(stats, arr[end] == current_val)) {
         end++;
     }
     if (end >= n) return end;
 
     // Detect run direction and expand
-    if (arr[end - 1] > arr[end]) {
+    if (BM_CMP(stats, arr[end - 1] > arr[end])) {
         // Descending run: reverse to make it ascending
-        while (end < n && arr[end - 1] > arr[end]) {
+        while (end < n && BM_CMP(stats, arr[end - 1] > arr[end])) {
             end++;
         }
         bm_reverse_slice(arr, start, end);
+        BM_STAT(stats, stats->moves += end - start);
     } else {
         // Ascending run
-        while (end < n && arr[end - 1] <= arr[end]) {
+        while (end < n && BM_CMP(stats, arr[end - 1] <= arr[end])) {
             end++;
         }
     }
@@ -68,14 +119,16 @@ static size_t bm_detect_segment(int* arr, size_t start, size_t n) {
 // Helper: Find lower and upper bound for a value in a sorted range
 // lower = first element >= value
 // upper = first element > value
-static void bm_bound_range(int* arr, size_t first, size_t last, int value, size_t* out_lower, size_t* out_upper) {
+static void bm_bound_range(int* arr, size_t first, size_t last, int value, size_t* out_lower, size_t* out_upper,
+                           SortStats* stats) {
+    (void)stats; // Only read by BM_CMP in SEGMENT_SORT_STATS builds
     size_t low = first;
     size_t high = last;
 
     // Find lower bound
     while (low < high) {
         const size_t mid = low + (high - low) / 2;
-        if (arr[mid] < value) {
+        if (BM_CMP(stats, arr[mid] < value)) {
             low = mid + 1;
         } else {
             high = mid;
@@ -87,7 +140,7 @@ static void bm_bound_range(int* arr, size_t first, size_t last, int value, size_
     high = last;
     while (low < high) {
         const size_t mid = low + (high - low) / 2;
-        if (arr[mid] <= value) {
+        if (BM_CMP(stats, arr[mid] <= value)) {
             low = mid + 1;
         } else {
             high = mid;
@@ -96,6 +149,34 @@ static void bm_bound_range(int* arr, size_t first, size_t last, int value, size_
     *out_upper = low;
 }
 
+// Helper: first element > value in a sorted range
+static size_t bm_upper_bound(int* arr, size_t first, size_t last, int value, SortStats* stats) {
+    (void)stats;
+    while (first < last) {
+        const size_t mid = first + (last - first) / 2;
+        if (BM_CMP(stats, arr[mid] <= value)) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+    return first;
+}
+
+// Helper: first element >= value in a sorted range
+static size_t bm_lower_bound(int* arr, size_t first, size_t last, int value, SortStats* stats) {
+    (void)stats;
+    while (first < last) {
+        const size_t mid = first + (last - first) / 2;
+        if (BM_CMP(stats, arr[mid] < value)) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+    return first;
+}
+
 // Helper: Rotate range [first, middle, last)
 static void bm_rotate_range(int* arr, size_t first, size_t middle, size_t last) {
     if (first >= middle || middle >= last) return;
@@ -104,9 +185,59 @@ static void bm_rotate_range(int* arr, size_t first, size_t middle, size_t last)
     bm_reverse_slice(arr, first, last);
 }
 
+// Helper: Swap [a, a + len) with [b, b + len) (non-overlapping)
+static void bm_swap_ranges(int* arr, size_t a, size_t b, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        int temp = arr[a + i];
+        arr[a + i] = arr[b + i];
+        arr[b + i] = temp;
+    }
+}
+
+// Helper: Rotate using the merge buffer. If the shorter side fits: memcpy it
+// out, memmove the longer side, memcpy it back. Otherwise Gries-Mills block
+// swaps (each swap puts the shorter side in its final place) until the
+// remaining shorter side fits. Without a buffer: triple reversal.
+// Returns the number of element moves.
+static size_t bm_rotate_with_buffer(int* arr, size_t first, size_t middle, size_t last, int* buffer, size_t buffer_size) {
+    size_t moves = 0;
+    if (buffer_size == 0) {
+        bm_rotate_range(arr, first, middle, last);
+        return 2 * (last - first);
+    }
+    while (first < middle && middle < last) {
+        size_t len1 = middle - first;
+        size_t len2 = last - middle;
+        if (len1 <= len2 && len1 <= buffer_size) {
+            memcpy(buffer, &arr[first], len1 * sizeof(int));
+            memmove(&arr[first], &arr[middle], len2 * sizeof(int));
+            memcpy(&arr[first + len2], buffer, len1 * sizeof(int));
+            return moves + 2 * len1 + len2;
+        }
+        if (len2 < len1 && len2 <= buffer_size) {
+            memcpy(buffer, &arr[middle], len2 * sizeof(int));
+            memmove(&arr[first + len2], &arr[first], len1 * sizeof(int));
+            memcpy(&arr[first], buffer, len2 * sizeof(int));
+            return moves + len1 + 2 * len2;
+        }
+        if (len1 <= len2) {
+            bm_swap_ranges(arr, first, middle, len1);  // A B1 B2 -> B1 A B2
+            moves += 2 * len1;
+            first = middle;
+            middle += len1;
+        } else {
+            bm_swap_ranges(arr, middle - len2, middle, len2);  // A1 A2 B -> A1 B A2
+            moves += 2 * len2;
+            last = middle;
+            middle -= len2;
+        }
+    }
+    return moves;
+}
+
 // Helper: Merge using buffer for left part
 // FIXED: Corrected duplicate handling logic
-static void bm_merge_with_buffer_left(int* arr, size_t first, size_t middle, size_t last, int* buffer) {
+static void bm_merge_with_buffer_left(int* arr, size_t first, size_t middle, size_t last, int* buffer, SortStats* stats) {
     const size_t len1 = middle - first;
     memcpy(buffer, arr + first, len1 * sizeof(int));
 
@@ -115,13 +246,13 @@ static void bm_merge_with_buffer_left(int* arr, size_t first, size_t middle, siz
     size_t k = first;  // Destination index
 
     while (i < len1 && j < last) {
-        if (buffer[i] <= arr[j]) {
+        if (BM_CMP(stats, buffer[i] <= arr[j])) {
             // Copy from buffer
             const int current_val = buffer[i];
             
             // Find end of duplicate range in buffer
             size_t i_end = i;
-            while (i_end < len1 && buffer[i_end] == current_val) {
+            while (i_end < len1 && BM_CMP(stats, buffer[i_end] == current_val)) {
                 i_end++;
             }
             
@@ -136,7 +267,7 @@ static void bm_merge_with_buffer_left(int* arr, size_t first, size_t middle, siz
             
             // Find end of duplicate range in right part
             size_t j_end = j;
-            while (j_end < last && arr[j_end] == current_val) {
+            while (j_end < last && BM_CMP(stats, arr[j_end] == current_val)) {
                 j_end++;
             }
             
@@ -151,12 +282,14 @@ static void bm_merge_with_buffer_left(int* arr, size_t first, size_t middle, siz
     // Copy remaining elements from buffer
     if (i < len1) {
         memcpy(arr + k, buffer + i, (len1 - i) * sizeof(int));
+        k += len1 - i;
     }
+    BM_STAT(stats, stats->moves += len1 + (k - first));
 }
 
 // Helper: Merge using buffer for right part
 // FIXED: Corrected duplicate handling logic
-static void bm_merge_with_buffer_right(int* arr, size_t first, size_t middle, size_t last, int* buffer) {
+static void bm_merge_with_buffer_right(int* arr, size_t first, size_t middle, size_t last, int* buffer, SortStats* stats) {
     const size_t len2 = last - middle;
     memcpy(buffer, arr + middle, len2 * sizeof(int));
 
@@ -165,19 +298,19 @@ static void bm_merge_with_buffer_right(int* arr, size_t first, size_t middle, si
     long k = (long)last - 1;   // Destination end index
 
     while (i >= (long)first && j >= 0) {
-        if (arr[i] > buffer[j]) {
+        if (BM_CMP(stats, arr[i] > buffer[j])) {
             // Copy from left part
             const int current_val = arr[i];
             
             // Find start of duplicate range in left part
             long i_start = i;
-            while (i_start >= (long)first && arr[i_start] == current_val) {
+            while (i_start >= (long)first && BM_CMP(stats, arr[i_start] == current_val)) {
                 i_start--;
             }
             
-            // Copy all duplicates from left part
+            // Copy all duplicates from left part (ranges may overlap)
             const size_t copy_count = i - i_start;
-            memcpy(arr + k - copy_count + 1, arr + i_start + 1, copy_count * sizeof(int));
+            memmove(arr + k - copy_count + 1, arr + i_start + 1, copy_count * sizeof(int));
             k -= copy_count;
             i = i_start;
         } else {
@@ -186,7 +319,7 @@ static void bm_merge_with_buffer_right(int* arr, size_t first, size_t middle, si
             
             // Find start of duplicate range in buffer
             long j_start = j;
-            while (j_start >= 0 && buffer[j_start] == current_val) {
+            while (j_start >= 0 && BM_CMP(stats, buffer[j_start] == current_val)) {
                 j_start--;
             }
             
@@ -202,42 +335,111 @@ static void bm_merge_with_buffer_right(int* arr, size_t first, size_t middle, si
     while (j >= 0) {
         arr[k--] = buffer[j--];
     }
+    BM_STAT(stats, stats->moves += len2 + (size_t)((long)last - 1 - k));
+}
+
+// Helper: Merge from both ends at once. Both runs are copied to the buffer;
+// each step writes the smallest remaining element to the front and the
+// largest to the back, so two independent comparison chains run in parallel.
+// min(len1, len2) double steps cannot cross, the rest is a forward merge.
+// Ties go left at the front and right at the back (stable). Branchless.
+static void bm_merge_bidirectional(int* arr, size_t first, size_t middle, size_t last, int* buffer, SortStats* stats) {
+    const size_t len1 = middle - first;
+    const size_t n = last - first;
+    memcpy(buffer, arr + first, n * sizeof(int));
+
+    size_t l = 0, r = len1;           // Front cursors
+    size_t l_tail = len1, r_tail = n; // Back cursors (one past)
+    int* out = arr + first;
+    int* out_tail = arr + last;
+
+    for (size_t steps = len1 < n - len1 ? len1 : n - len1; steps > 0; --steps) {
+        const int front_right = BM_CMP(stats, buffer[r] < buffer[l]);
+        *out++ = buffer[front_right ? r : l];
+        r += front_right;
+        l += !front_right;
+
+        const int back_left = BM_CMP(stats, buffer[r_tail - 1] < buffer[l_tail - 1]);
+        *--out_tail = buffer[back_left ? l_tail - 1 : r_tail - 1];
+        l_tail -= back_left;
+        r_tail -= !back_left;
+    }
+
+    while (l < l_tail && r < r_tail) {
+        const int take_right = BM_CMP(stats, buffer[r] < buffer[l]);
+        *out++ = buffer[take_right ? r : l];
+        r += take_right;
+        l += !take_right;
+    }
+    memcpy(out, buffer + l, (l_tail - l) * sizeof(int));
+    out += l_tail - l;
+    memcpy(out, buffer + r, (r_tail - r) * sizeof(int));
+    BM_STAT(stats, stats->moves += 2 * n);
 }
 
 // Core: Buffered Merge (Hybrid)
 // Optimized: Uses bound ranges for SymMerge to handle duplicates in bulk
-static void bm_buffered_merge(int* arr, size_t first, size_t middle, size_t last, int* buffer, size_t buffer_size) {
+// depth is the SymMerge recursion depth (only tracked for stats).
+static void bm_buffered_merge(int* arr, size_t first, size_t middle, size_t last, int* buffer, size_t buffer_size,
+                              SortStats* stats, size_t depth) {
     if (first >= middle || middle >= last) return;
     
-    const size_t len1 = middle - first;
-    const size_t len2 = last - middle;
+    BM_STAT(stats, if (depth > stats->max_recursion_depth) stats->max_recursion_depth = depth);
 
     // Early exit: already sorted
-    if (arr[middle - 1] <= arr[middle]) return;
+    if (BM_CMP(stats, arr[middle - 1] <= arr[middle])) {
+        BM_STAT(stats, stats->skipped_merges++);
+        return;
+    }
+
+    // Trim what is already in place: left elements not above the first
+    // right one, right elements not below the last left one
+    first = bm_upper_bound(arr, first, middle, arr[middle], stats);
+    last = bm_lower_bound(arr, middle, last, arr[middle - 1], stats);
+    const size_t len1 = middle - first;
+    const size_t len2 = last - middle;
 
-    // Strategy 1: Use buffer if segment fits
+    // Strategy 1: Use buffer if segment fits. When both runs fit and are
+    // not too lopsided, merge from both ends
+    if (SEGMENT_SORT_BIDIRECTIONAL_MERGE && len1 + len2 <= buffer_size &&
+        4 * (len1 < len2 ? len1 : len2) >= len1 + len2) {
+        BM_STAT(stats, stats->buffer_merges++);
+        bm_merge_bidirectional(arr, first, middle, last, buffer, stats);
+        return;
+    }
     if (len1 <= buffer_size) {
-        bm_merge_with_buffer_left(arr, first, middle, last, buffer);
+        BM_STAT(stats, stats->buffer_merges++);
+        bm_merge_with_buffer_left(arr, first, middle, last, buffer, stats);
         return;
     }
     if (len2 <= buffer_size) {
-        bm_merge_with_buffer_right(arr, first, middle, last, buffer);
+        BM_STAT(stats, stats->buffer_merges++);
+        bm_merge_with_buffer_right(arr, first, middle, last, buffer, stats);
         return;
     }
+    BM_STAT(stats, stats->symmerge_splits++);
 
     // Strategy 2: SymMerge optimized for duplicate ranges
     const size_t mid1 = first + (middle - first) / 2;
     const int value = arr[mid1];
     size_t lower, upper;
-    bm_bound_range(arr, middle, last, value, &lower, &upper);
+    bm_bound_range(arr, middle, last, value, &lower, &upper, stats);
     
     const size_t newMid = mid1 + (lower - middle);
     
     // Rotate entire duplicate range in one step
-    bm_rotate_range(arr, mid1, middle, upper);
+    const size_t rotate_moves = bm_rotate_with_buffer(arr, mid1, middle, upper, buffer, buffer_size);
+    BM_STAT(stats, {
+        const size_t rotated = upper - mid1;
+        stats->rotations++;
+        stats->rotated_elements += rotated;
+        stats->moves += rotate_moves;
+        if (rotated > stats->max_rotation) stats->max_rotation = rotated;
+    });
+    (void)rotate_moves;
     
-    bm_buffered_merge(arr, first, mid1, newMid, buffer, buffer_size);
-    bm_buffered_merge(arr, newMid + 1, upper, last, buffer, buffer_size);
+    bm_buffered_merge(arr, first, mid1, newMid, buffer, buffer_size, stats, depth + 1);
+    bm_buffered_merge(arr, newMid + 1, upper, last, buffer, buffer_size, stats, depth + 1);
 }
 
 /**
@@ -266,8 +468,11 @@ static void bm_buffered_merge(int* arr, size_t first, size_t middle, size_t last
  * 
  * @param arr Pointer to the array to sort.
  * @param n Number of elements in the array.
+ * @param stats Optional counters (may be NULL); zeroed on entry and only
+ *        filled when compiled with -DSEGMENT_SORT_STATS.
  */
-void block_merge_segment_sort(int* arr, size_t n) {
+void block_merge_segment_sort_with_stats(int* arr, size_t n, SortStats* stats) {
+    if (stats) memset(stats, 0, sizeof(*stats));
     if (n <= 1) return;
 
     const size_t buffer_size = BLOCK_MERGE_DEFAULT_BUFFER_SIZE;
@@ -288,7 +493,11 @@ void block_merge_segment_sort(int* arr, size_t n) {
     size_t i = 0;
     while (i < n) {
         // 1. Detect next sorted run
-        const size_t end = bm_detect_segment(arr, i, n);
+        const size_t end = bm_detect_segment(arr, i, n, stats);
+        BM_STAT(stats, {
+            stats->runs++;
+            stats->run_length_histogram[bm_log2_bucket(end - i)]++;
+        });
         
         size_t current_start = i;
         size_t current_end = end;
@@ -306,7 +515,7 @@ void block_merge_segment_sort(int* arr, size_t n) {
             }
 
             // Merge top of stack with current run
-            bm_buffered_merge(arr, stack[top_idx].start, current_start, current_end, buffer, buffer_size);
+            bm_buffered_merge(arr, stack[top_idx].start, current_start, current_end, buffer, buffer_size, stats, 0);
             
             // Update current run to include merged segment
             current_start = stack[top_idx].start;
@@ -317,6 +526,7 @@ void block_merge_segment_sort(int* arr, size_t n) {
         stack[stack_top].start = current_start;
         stack[stack_top].end = current_end;
         stack_top++;
+        BM_STAT(stats, if ((size_t)stack_top > stats->max_stack_depth) stats->max_stack_depth = stack_top);
     }
 
     // 4. Merge all remaining segments in the stack
@@ -324,7 +534,7 @@ void block_merge_segment_sort(int* arr, size_t n) {
         const size_t b_idx = stack_top - 1;
         const size_t a_idx = stack_top - 2;
         
-        bm_buffered_merge(arr, stack[a_idx].start, stack[b_idx].start, stack[b_idx].end, buffer, buffer_size);
+        bm_buffered_merge(arr, stack[a_idx].start, stack[b_idx].start, stack[b_idx].end, buffer, buffer_size, stats, 0);
         
         stack[a_idx].end = stack[b_idx].end;
         stack_top--;
@@ -334,4 +544,9 @@ void block_merge_segment_sort(int* arr, size_t n) {
     free(buffer);
 }
 
+// Sort without statistics (see block_merge_segment_sort_with_stats)
+void block_merge_segment_sort(int* arr, size_t n) {
+    block_merge_segment_sort_with_stats(arr, n, NULL);
+}
+
 #endif // BLOCK_MERGE_SEGMENT_SORT_H
\ No newline at end of file
@@ -30,16 +30,18 @@ private:
         int step;       // +1 para ascendentes, -1 para descendentes
         int value;      // Valor actual (caché para comparación)
         
-        // Necesario para depuración
+        // Orden del segmento en la entrada (desempate estable)
         int id; 
     };
 
     // Comparador para el Min-Heap
     // Nota: priority_queue ordena de mayor a menor por defecto.
     // Para un Min-Heap, debemos devolver true si a > b.
+    // En empate gana el segmento anterior en la entrada (estabilidad).
     struct CompareRunCursor {
         bool operator()(const RunCursor &a, const RunCursor &b) {
-            return a.value > b.value;
+            if (a.value != b.value) return a.value > b.value;
+            return a.id > b.id;
         }
     };
 
@@ -52,65 +54,28 @@ private:
     /**
      * Escanea el array para identificar segmentos naturales y
      * carga el primer elemento de cada uno en el Heap.
+     *
+     * Estabilidad: los segmentos son no-descendentes o estrictamente
+     * descendentes. Un segmento descendente estricto no contiene duplicados,
+     * así que recorrerlo hacia atrás no invierte elementos iguales.
      */
     void initialize() {
         int n = sourceRef.size();
-        if (n == 0) return;
-
-        int start = 0;
-        
-        // Recorremos buscando cortes
-        for (int i = 1; i < n; ++i) {
-            // Lógica simple de detección:
-            // Si la tendencia se rompe drásticamente, cortamos.
-            // Nota: Para ser robusto con duplicados, consideramos <= como continuación de ascendente
-            
-            bool isAscendingOrder = sourceRef[i-1] <= sourceRef[i];
-            
-            // Aquí podríamos poner lógica más compleja de detección.
-            // Por simplicidad, usamos una estrategia Greedy simple:
-            // Cortamos segmento si cambiamos de ascendente a descendente estricto o viceversa.
-            // (Esta es una simplificación del original para el iterador, pero funciona).
-            
-            // Para mantener la lógica de tu original:
-            // Vamos a detectar "Runs" largos.
-        }
-
-        // RE-IMPLEMENTACIÓN DE TU LÓGICA DE DETECCIÓN ORIGINAL
-        // Adaptada para crear cursores inmediatamente
-        
         int runStart = 0;
-        if (n == 0) return;
-        
-        // 0: desconocido, 1: ascendente, -1: descendente
-        int direction = 0; 
 
-        for (int i = 1; i < n; ++i) {
-            int diff = sourceRef[i] - sourceRef[i-1];
-            
-            if (diff == 0) continue; // Ignorar duplicados para determinar dirección inicial
-
-            int currentDir = (diff > 0) ? 1 : -1;
-
-            if (direction == 0) {
-                direction = currentDir;
-                continue;
-            }
-
-            // Si la dirección cambia, tenemos un segmento
-            if (currentDir != direction) {
-                addSegmentToHeap(runStart, i - 1, direction);
-                runStart = i; // El elemento actual empieza el nuevo segmento (solapamiento opcional)
-                // Nota: En tu original, i era parte del nuevo. 
-                // Ajuste: i empieza el nuevo. i-1 terminó el anterior.
-                
-                runStart = i;
-                direction = 0; // Reset direction
+        while (runStart < n) {
+            int end = runStart + 1;
+            if (end < n && sourceRef[end] < sourceRef[runStart]) {
+                // Descendente estricto
+                while (end < n && sourceRef[end] < sourceRef[end - 1]) end++;
+                addSegmentToHeap(runStart, end - 1, -1);
+            } else {
+                // Ascendente (admite iguales)
+                while (end < n && sourceRef[end - 1] <= sourceRef[end]) end++;
+                addSegmentToHeap(runStart, end - 1, 1);
             }
+            runStart = end;
         }
-        
-        // Añadir el último segmento
-        addSegmentToHeap(runStart, n - 1, (direction == 0 ? 1 : direction));
     }
 
     void addSegmentToHeap(int startIdx, int endIdx, int direction) {
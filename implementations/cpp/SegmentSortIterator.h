@@ -5,78 +5,82 @@
 #include <queue>
 #include <stdexcept>
 #include <algorithm>
+#include <functional>
 
 // Define namespace to avoid collisions
 namespace SegmentSort {
 
 /**
  * SegmentSortIterator
- * 
+ *
  * A "Lazy" sorting iterator designed for Top-K queries and streaming.
- * 
+ *
  * Advantages:
  * 1. Zero-copy (Const reference to source).
  * 2. Low auxiliary memory O(K) where K is number of segments.
  * 3. O(N) initialization cost.
  * 4. O(log K) cost per element extracted.
+ *
+ * Stability: runs are non-descending or strictly descending (same rule as
+ * detect_segment in block_merge_segment_sort.h), so walking a descending run
+ * backwards never reorders equal elements. Ties between runs are broken by
+ * run id, i.e. by position in the input. Equal elements are therefore
+ * returned in input order.
+ *
+ * Usage: SegmentSort::Iterator iter(data); // T and Compare deduced (C++17)
  */
+template<typename T = int, typename Compare = std::less<T>>
 class Iterator
 {
 private:
     // Reference to original vector
-    const std::vector<int>& sourceRef;
+    const std::vector<T>& sourceRef;
+    Compare comp;
 
     // Internal cursor for Heap
     struct RunCursor {
-        int currentIdx; 
-        int remaining;  
+        size_t currentIdx;
+        size_t remaining;
         int step;       // +1 for ascending, -1 for descending
-        int value;      
-        int id;         // For stability/debugging
+        T value;
+        size_t id;      // Run order in the input (tie-break for stability)
     };
 
     // Min-Heap Comparator (inverted logic for priority_queue)
     struct CompareRunCursor {
-        bool operator()(const RunCursor &a, const RunCursor &b) {
-            return a.value > b.value;
+        Compare comp;
+        bool operator()(const RunCursor &a, const RunCursor &b) const {
+            if (comp(b.value, a.value)) return true;
+            if (comp(a.value, b.value)) return false;
+            return a.id > b.id;
         }
     };
 
     std::priority_queue<RunCursor, std::vector<RunCursor>, CompareRunCursor> minHeap;
-    int totalSegments = 0;
+    size_t totalSegments = 0;
 
     void initialize() {
-        int n = sourceRef.size();
-        if (n == 0) return;
-
-        int runStart = 0;
-        int direction = 0; // 0: unknown, 1: asc, -1: desc
-
-        for (int i = 1; i < n; ++i) {
-            long long diff = (long long)sourceRef[i] - sourceRef[i-1];
-            
-            if (diff == 0) continue; 
-
-            int currentDir = (diff > 0) ? 1 : -1;
-
-            if (direction == 0) {
-                direction = currentDir;
-                continue;
-            }
-
-            if (currentDir != direction) {
-                addSegmentToHeap(runStart, i - 1, direction);
-                runStart = i;
-                direction = 0; 
+        size_t n = sourceRef.size();
+        size_t runStart = 0;
+
+        while (runStart < n) {
+            size_t end = runStart + 1;
+            if (end < n && comp(sourceRef[end], sourceRef[runStart])) {
+                // Strictly descending run
+                while (end < n && comp(sourceRef[end], sourceRef[end - 1])) end++;
+                addSegmentToHeap(runStart, end - 1, -1);
+            } else {
+                // Non-descending run
+                while (end < n && !comp(sourceRef[end], sourceRef[end - 1])) end++;
+                addSegmentToHeap(runStart, end - 1, 1);
             }
+            runStart = end;
         }
-        // Add last segment
-        addSegmentToHeap(runStart, n - 1, (direction == 0 ? 1 : direction));
     }
 
-    void addSegmentToHeap(int startIdx, int endIdx, int direction) {
+    void addSegmentToHeap(size_t startIdx, size_t endIdx, int direction) {
         if (startIdx > endIdx) return;
-        
+
         RunCursor cursor;
         cursor.remaining = (endIdx - startIdx) + 1;
         cursor.id = totalSegments++;
@@ -94,7 +98,8 @@ private:
     }
 
 public:
-    Iterator(const std::vector<int>& input) : sourceRef(input) {
+    Iterator(const std::vector<T>& input, Compare c = Compare())
+        : sourceRef(input), comp(c), minHeap(CompareRunCursor{c}) {
         initialize();
     }
 
@@ -102,7 +107,7 @@ public:
         return !minHeap.empty();
     }
 
-    int next() {
+    T next() {
         if (minHeap.empty()) {
             throw std::out_of_range("No more elements");
         }
@@ -110,7 +115,7 @@ public:
         RunCursor current = minHeap.top();
         minHeap.pop();
 
-        int retValue = current.value;
+        T retValue = current.value;
 
         current.remaining--;
 
@@ -123,8 +128,8 @@ public:
         return retValue;
     }
 
-    std::vector<int> nextBatch(int k) {
-        std::vector<int> batch;
+    std::vector<T> nextBatch(int k) {
+        std::vector<T> batch;
         batch.reserve(k);
         for (int i = 0; i < k && hasNext(); i++) {
             batch.push_back(next());
@@ -133,7 +138,7 @@ public:
     }
 
     int getSegmentCount() const {
-        return totalSegments;
+        return static_cast<int>(totalSegments);
     }
 };
 
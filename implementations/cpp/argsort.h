@@ -0,0 +1,251 @@
+/**
+ * Argsort (Stable Permutation) - C++ Implementation
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Computes the stable sorting permutation of a read-only array with the
+ * Block Merge Segment Sort machinery: perm[0..n) such that
+ * data[perm[0]] <= data[perm[1]] <= ... and equal elements keep their input
+ * order. The input is never modified.
+ *
+ * - Runs are detected on the data itself: ascending runs produce identity
+ *   index ranges, strictly descending runs produce reversed ranges.
+ * - Merges move indices and compare data[idx], prefetching the data of the
+ *   indices a few positions ahead of both merge cursors.
+ * - uint32_t indices (n < 2^32) halve the merge bandwidth of uint64_t indices.
+ */
+
+#ifndef ARGSORT_HPP
+#define ARGSORT_HPP
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <functional>
+
+#include "block_merge_segment_sort.h"
+
+// How many indices ahead of each merge cursor the data is prefetched
+const size_t ARGSORT_PREFETCH_DISTANCE = 8;
+
+namespace segment_sort {
+
+    // Compares indices by the data they point to
+    template<typename T, typename Compare>
+    struct IndirectCompare {
+        const T* data;
+        Compare comp;
+
+        template<typename IndexT>
+        bool operator()(IndexT a, IndexT b) const {
+            return comp(data[a], data[b]);
+        }
+    };
+
+    // Helper: Detect the run of data starting at start and write its index range.
+    // Strictly descending runs are written reversed (stable, like detect_segment).
+    template<typename T, typename IndexT, typename Compare>
+    size_t detect_index_segment(const T* data, IndexT* perm, size_t start, size_t n, Compare comp) {
+        if (start >= n) return start;
+
+        size_t end = start + 1;
+        if (end < n && comp(data[end], data[start])) {
+            // Descending run
+            while (end < n && comp(data[end], data[end - 1])) {
+                end++;
+            }
+            for (size_t k = start; k < end; ++k) {
+                perm[k] = static_cast<IndexT>(end - 1 - (k - start));
+            }
+        } else {
+            // Ascending run
+            while (end < n && !comp(data[end], data[end - 1])) {
+                end++;
+            }
+            for (size_t k = start; k < end; ++k) {
+                perm[k] = static_cast<IndexT>(k);
+            }
+        }
+        return end;
+    }
+
+    // Helper: Merge index runs using buffer for left part
+    template<typename T, typename IndexT, typename Compare>
+    void merge_indices_with_buffer_left(const T* data, IndexT* perm, size_t first, size_t middle, size_t last,
+                                        std::vector<IndexT>& buffer, Compare comp) {
+        size_t len1 = middle - first;
+
+        if (buffer.size() < len1) buffer.resize(len1);
+        std::copy(perm + first, perm + middle, buffer.begin());
+
+        size_t i = 0;      // buffer index
+        size_t j = middle; // right part index
+        size_t k = first;  // dest index
+
+        while (i < len1 && j < last) {
+            if (i + ARGSORT_PREFETCH_DISTANCE < len1) SEGMENT_SORT_PREFETCH(data + buffer[i + ARGSORT_PREFETCH_DISTANCE]);
+            if (j + ARGSORT_PREFETCH_DISTANCE < last) SEGMENT_SORT_PREFETCH(data + perm[j + ARGSORT_PREFETCH_DISTANCE]);
+            if (!comp(data[perm[j]], data[buffer[i]])) {
+                perm[k++] = buffer[i++];
+            } else {
+                perm[k++] = perm[j++];
+            }
+        }
+        while (i < len1) {
+            perm[k++] = buffer[i++];
+        }
+    }
+
+    // Helper: Merge index runs using buffer for right part
+    template<typename T, typename IndexT, typename Compare>
+    void merge_indices_with_buffer_right(const T* data, IndexT* perm, size_t first, size_t middle, size_t last,
+                                         std::vector<IndexT>& buffer, Compare comp) {
+        size_t len2 = last - middle;
+
+        if (buffer.size() < len2) buffer.resize(len2);
+        std::copy(perm + middle, perm + last, buffer.begin());
+
+        long i = (long)middle - 1; // left part index
+        long j = (long)len2 - 1;   // buffer index
+        long k = (long)last - 1;   // dest index
+        const long d = (long)ARGSORT_PREFETCH_DISTANCE;
+
+        while (i >= (long)first && j >= 0) {
+            if (i - d >= (long)first) SEGMENT_SORT_PREFETCH(data + perm[i - d]);
+            if (j - d >= 0) SEGMENT_SORT_PREFETCH(data + buffer[j - d]);
+            if (comp(data[buffer[j]], data[perm[i]])) {
+                perm[k--] = perm[i--];
+            } else {
+                perm[k--] = buffer[j--];
+            }
+        }
+        while (j >= 0) {
+            perm[k--] = buffer[j--];
+        }
+    }
+
+    // Core: Buffered Merge over indices (same strategy as buffered_merge)
+    template<typename T, typename IndexT, typename Compare>
+    void indirect_buffered_merge(const T* data, IndexT* perm, size_t first, size_t middle, size_t last,
+                                 std::vector<IndexT>& buffer, size_t buffer_limit, Compare comp) {
+        if (first >= middle || middle >= last) return;
+
+        size_t len1 = middle - first;
+        size_t len2 = last - middle;
+
+        // Optimization: Already sorted?
+        if (!comp(data[perm[middle]], data[perm[middle - 1]])) return;
+
+        // Strategy 1: Use buffer if small enough
+        if (len1 <= buffer_limit) {
+            merge_indices_with_buffer_left(data, perm, first, middle, last, buffer, comp);
+            return;
+        }
+        if (len2 <= buffer_limit) {
+            merge_indices_with_buffer_right(data, perm, first, middle, last, buffer, comp);
+            return;
+        }
+
+        // Strategy 2: SymMerge (Divide and Conquer)
+        size_t mid1 = first + (middle - first) / 2;
+        IndexT value = perm[mid1];
+
+        IndirectCompare<T, Compare> icomp{data, comp};
+        IndexT* it = branchless_lower_bound(perm + middle, perm + last, value, icomp);
+        size_t mid2 = it - perm;
+
+        size_t newMid = mid1 + (mid2 - middle);
+
+        rotate_with_buffer(perm, mid1, middle, mid2, buffer, buffer_limit);
+
+        indirect_buffered_merge(data, perm, first, mid1, newMid, buffer, buffer_limit, comp);
+        indirect_buffered_merge(data, perm, newMid + 1, mid2, last, buffer, buffer_limit, comp);
+    }
+
+    template<size_t MinRun, typename MergePolicy, typename T, typename IndexT, typename Compare>
+    void argsort_impl(const T* data, size_t n, IndexT* perm, size_t buffer_size, Compare comp) {
+        if (n == 0) return;
+        if (n == 1) { perm[0] = 0; return; }
+
+        const size_t min_run = compute_min_run(n, MinRun);
+        IndirectCompare<T, Compare> icomp{data, comp};
+        // The buffer holds indices, so the auto sizes are counted in IndexT
+        buffer_size = resolve_buffer_size<IndexT>(n, buffer_size);
+
+        std::vector<IndexT> buffer;
+        buffer.reserve(std::min(buffer_size, n));
+
+        std::vector<Segment> stack;
+        stack.reserve(64);
+
+        auto merge = [&](const Segment& a, const Segment& b) {
+            indirect_buffered_merge(data, perm, a.start, b.start, b.end, buffer, buffer_size, comp);
+            return Segment{a.start, b.end, 0};
+        };
+
+        size_t i = 0;
+        while (i < n) {
+            // 1. Detect next run on the data, emit its index range
+            size_t end = detect_index_segment(data, perm, i, n, comp);
+
+            // Extend short runs to min_run (indices not yet written start as identity)
+            if (end - i < min_run && end < n) {
+                size_t forced_end = std::min(n, i + min_run);
+                for (size_t k = end; k < forced_end; ++k) perm[k] = static_cast<IndexT>(k);
+                extend_run(perm, i, end, forced_end, icomp);
+                end = forced_end;
+            }
+
+            // 2. Push the run, merging as dictated by the policy
+            MergePolicy::push_run(stack, Segment{i, end, 0}, n, merge);
+            i = end;
+        }
+
+        // 3. Force merge remaining segments
+        while (stack.size() > 1) {
+            Segment b = stack.back(); stack.pop_back();
+            Segment a = stack.back(); stack.pop_back();
+            stack.push_back(merge(a, b));
+        }
+    }
+
+    /**
+     * @brief Stable argsort: perm receives the sorting permutation of data.
+     *
+     * @tparam MinRun Upper bound for the min run length (0 disables extension).
+     * @tparam MergePolicy Stack merge rule (see block_merge_segment_sort).
+     * @param data Pointer to the (read-only) data.
+     * @param n Number of elements; must be <= UINT32_MAX for uint32_t indices.
+     * @param perm Output array of n indices.
+     * @param comp Comparison function object (default std::less<T>).
+     */
+    template<size_t MinRun = BLOCK_MERGE_DEFAULT_MIN_RUN,
+             typename MergePolicy = BalancedMergePolicy,
+             typename T, typename Compare = std::less<T>>
+    void argsort(const T* data, size_t n, uint32_t* perm, Compare comp = Compare()) {
+        if (n > std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("argsort: n does not fit in 32-bit indices, use uint64_t indices");
+        }
+        argsort_impl<MinRun, MergePolicy>(data, n, perm, BLOCK_MERGE_DEFAULT_BUFFER_SIZE, comp);
+    }
+
+    // 64-bit index version for n >= 2^32.
+    template<size_t MinRun = BLOCK_MERGE_DEFAULT_MIN_RUN,
+             typename MergePolicy = BalancedMergePolicy,
+             typename T, typename Compare = std::less<T>>
+    void argsort(const T* data, size_t n, uint64_t* perm, Compare comp = Compare()) {
+        argsort_impl<MinRun, MergePolicy>(data, n, perm, BLOCK_MERGE_DEFAULT_BUFFER_SIZE, comp);
+    }
+
+    // Vector overload returning 32-bit indices.
+    template<typename T>
+    std::vector<uint32_t> argsort(const std::vector<T>& data) {
+        std::vector<uint32_t> perm(data.size());
+        argsort(data.data(), data.size(), perm.data());
+        return perm;
+    }
+}
+
+#endif // ARGSORT_HPP
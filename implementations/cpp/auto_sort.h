@@ -0,0 +1,321 @@
+/**
+ * Presortedness Probe and Algorithm Selection - C++ Implementation
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * segment_sort::analyze(first, last) measures how sorted an input already
+ * is, and segment_sort::sort(arr, n, comp) uses those measures to pick an
+ * algorithm:
+ *
+ * - Block merge (block_merge_segment_sort) for inputs made of a few runs
+ *   (sorted, reversed, a handful of sorted blocks), for small inputs and
+ *   for every key type where equal elements can be told apart. It is the
+ *   only stable choice.
+ * - Counting sort for integral keys whose value range is small next to n.
+ * - pdqsort (pattern-defeating quicksort, pdqsort.h) for integral inputs
+ *   with long runs or few distinct values, and for small random ones.
+ * - LSD radix sort for large random integral inputs.
+ *
+ * Counting, radix and pdqsort are unstable or reorder by value only, so
+ * they are restricted to integral keys under std::less / std::greater, the
+ * same rule as the sorting network pre-pass (network_sortable): equal keys
+ * are indistinguishable and the result equals the stable one.
+ *
+ * The thresholds live in SortDecisionTable; choose_algorithm() is the
+ * decision table itself, exposed so it can be tuned or logged
+ * (benchmark_auto_sort prints the choice per input).
+ */
+
+#ifndef AUTO_SORT_HPP
+#define AUTO_SORT_HPP
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+#include "block_merge_segment_sort.h"
+#include "pdqsort.h"
+
+namespace segment_sort {
+
+    // Keys that counting, radix and pdqsort may sort: network_sortable
+    // (integral, std::less / std::greater) except bool
+    template<typename T, typename Compare>
+    struct radix_sortable : std::integral_constant<bool,
+        network_sortable<T, Compare>::value && !std::is_same<T, bool>::value> {};
+
+    /**
+     * Presortedness measures returned by analyze(). The adjacent-pair
+     * counts come from one branch-free pass; inversions and duplicates are
+     * estimated from fixed-size samples. GCC 12 vectorizes that pass only
+     * at -O3 (the CMake Release flags): int32 keys with SSE2 or AVX2,
+     * int64 and double keys with AVX2 only. At -O2 it stays scalar.
+     */
+    struct Presortedness {
+        size_t n = 0;
+        size_t runs = 0;                  // Monotone runs, estimated from direction changes (as detect_segment counts them)
+        double avg_run_length = 0.0;      // n / runs
+        double descending_fraction = 0.0; // Share of adjacent pairs in descending order (0 sorted, ~0.5 random, 1 reversed)
+        double duplicate_ratio = 0.0;     // 1 - distinct / sampled elements (0 all distinct, -> 1 few values)
+        double inversion_ratio = 0.0;     // Sampled pairs i < j with a[j] < a[i] (0 sorted, ~0.5 random, 1 reversed)
+        bool integral_keys = false;       // Radix / counting / pdqsort allowed (radix_sortable)
+        uint64_t key_range = 0;           // max - min for integral keys (0 otherwise)
+    };
+
+    // Algorithms segment_sort::sort can dispatch to
+    enum class SortAlgorithm {
+        BlockMerge,
+        Counting,
+        Radix,
+        Pdqsort
+    };
+
+    inline const char* sort_algorithm_name(SortAlgorithm algorithm) {
+        switch (algorithm) {
+            case SortAlgorithm::Counting: return "counting";
+            case SortAlgorithm::Radix: return "radix";
+            case SortAlgorithm::Pdqsort: return "pdqsort";
+            default: return "block merge";
+        }
+    }
+
+    /**
+     * Thresholds of choose_algorithm. The defaults come from
+     * benchmark_auto_sort on int32/int64 (1K, 64K and 1M elements).
+     */
+    struct SortDecisionTable {
+        size_t small_n = 256;                 // Below this, block merge (insertion sort + one merge level)
+        size_t presorted_max_runs = 64;       // At most this many runs: block merge (O(n log runs) merging)
+        double counting_range_factor = 1.0;  // Counting sort when key_range + 1 <= factor * n ...
+        uint64_t counting_max_range = 1u << 22; // ... and the count array stays this small
+        double long_run_length = 16.0;        // avg_run_length at or above this: pdqsort (it keeps runs)
+        double duplicate_ratio = 0.9;         // duplicate_ratio at or above this: pdqsort (equal-key partitions)
+        size_t radix_min_n = 1u << 10;        // Random integral keys from this size: radix, below: pdqsort
+        size_t sample_size = 1024;            // Most pairs / elements sampled for inversions and duplicates
+    };
+
+    /**
+     * The decision table: which algorithm segment_sort::sort runs for an
+     * input with measures p. Order of the checks:
+     * 1. small inputs or a few runs -> block merge (O(n) on sorted or
+     *    reversed data, a few merge levels otherwise);
+     * 2. keys that are not integral under std::less / std::greater -> block
+     *    merge (only stable choice);
+     * 3. small key range -> counting sort (also for nearly sorted
+     *    permutations: one pass beats any merge);
+     * 4. long runs or few distinct values -> pdqsort;
+     * 5. large random input -> radix sort, otherwise pdqsort.
+     * On integral keys radix sort beats merging as soon as there are more
+     * than a few dozen runs, short runs included (k-sorted data).
+     */
+    inline SortAlgorithm choose_algorithm(const Presortedness& p, const SortDecisionTable& table = SortDecisionTable()) {
+        if (p.n < table.small_n || p.runs <= table.presorted_max_runs) return SortAlgorithm::BlockMerge;
+        if (!p.integral_keys) return SortAlgorithm::BlockMerge;
+        if (p.key_range < table.counting_max_range &&
+            static_cast<double>(p.key_range) + 1.0 <= table.counting_range_factor * static_cast<double>(p.n)) {
+            return SortAlgorithm::Counting;
+        }
+        if (p.avg_run_length >= table.long_run_length || p.duplicate_ratio >= table.duplicate_ratio) {
+            return SortAlgorithm::Pdqsort;
+        }
+        return p.n >= table.radix_min_n ? SortAlgorithm::Radix : SortAlgorithm::Pdqsort;
+    }
+
+    // Helper: integral key as an unsigned value with the same order
+    template<typename T>
+    inline typename std::make_unsigned<T>::type ordered_bits(T key) {
+        using U = typename std::make_unsigned<T>::type;
+        U bits = static_cast<U>(key);
+        if (std::is_signed<T>::value) bits ^= U(1) << (sizeof(T) * 8 - 1);
+        return bits;
+    }
+
+    /**
+     * Measures the presortedness of [first, last) under comp. One pass over
+     * adjacent pairs counts descents and direction changes (and the key
+     * range for integral keys); up to sample_size deterministic pairs
+     * estimate the inversion ratio and a sorted sample of as many elements
+     * the duplicate ratio (n / 16 of each, at least 64, on small inputs).
+     */
+    template<typename RandomIt, typename Compare>
+    Presortedness analyze(RandomIt first, RandomIt last, Compare comp, size_t sample_size = 1024) {
+        using T = typename std::iterator_traits<RandomIt>::value_type;
+        Presortedness p;
+        const size_t n = static_cast<size_t>(last - first);
+        p.n = n;
+        p.integral_keys = radix_sortable<T, Compare>::value;
+        if (n < 2) {
+            p.runs = n;
+            p.avg_run_length = static_cast<double>(n);
+            return p;
+        }
+
+        // 1. Adjacent pairs: descents, direction changes and the key range,
+        // no branches
+        size_t descents = comp(first[1], first[0]);
+        size_t turns = 0;
+        T lo = first[0];
+        T hi = first[0];
+        if constexpr (radix_sortable<T, Compare>::value) {
+            lo = std::min(lo, first[1]);
+            hi = std::max(hi, first[1]);
+        }
+        for (size_t i = 2; i < n; ++i) {
+            const bool down = comp(first[i], first[i - 1]);
+            const bool prev_down = comp(first[i - 1], first[i - 2]);
+            descents += down;
+            turns += down != prev_down;
+            if constexpr (radix_sortable<T, Compare>::value) {
+                lo = std::min(lo, first[i]);
+                hi = std::max(hi, first[i]);
+            }
+        }
+        // An interior run of either direction starts and ends with a turn
+        p.runs = turns / 2 + 1;
+        p.avg_run_length = static_cast<double>(n) / static_cast<double>(p.runs);
+        p.descending_fraction = static_cast<double>(descents) / static_cast<double>(n - 1);
+
+        if constexpr (radix_sortable<T, Compare>::value) {
+            p.key_range = static_cast<uint64_t>(ordered_bits(hi) - ordered_bits(lo));
+        }
+
+        // 2. Sampled inversions: pairs (i, j) from a fixed LCG, i < j
+        const size_t samples = std::min({sample_size, n, std::max<size_t>(64, n / 16)});
+        uint64_t state = 0x9E3779B97F4A7C15ull;
+        size_t inversions = 0;
+        for (size_t s = 0; s < samples; ++s) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            size_t i = static_cast<size_t>((state >> 16) % n);
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            size_t j = static_cast<size_t>((state >> 16) % n);
+            if (i > j) std::swap(i, j);
+            inversions += i != j && comp(first[j], first[i]);
+        }
+        p.inversion_ratio = static_cast<double>(inversions) / static_cast<double>(samples);
+
+        // 3. Duplicates: distinct values in an evenly spaced sample
+        std::vector<T> sample;
+        sample.reserve(samples);
+        for (size_t s = 0; s < samples; ++s) sample.push_back(first[s * n / samples]);
+        std::sort(sample.begin(), sample.end(), comp);
+        size_t distinct = 1;
+        for (size_t s = 1; s < samples; ++s) distinct += comp(sample[s - 1], sample[s]);
+        p.duplicate_ratio = 1.0 - static_cast<double>(distinct) / static_cast<double>(samples);
+        return p;
+    }
+
+    // analyze with operator<
+    template<typename RandomIt>
+    Presortedness analyze(RandomIt first, RandomIt last) {
+        return segment_sort::analyze(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+    }
+
+    /**
+     * Counting sort of integral keys in [min_key, min_key + range]. Ascending
+     * unless descending is set (std::greater). O(n + range) time, range + 1
+     * counters.
+     */
+    template<typename T>
+    void counting_sort(T* arr, size_t n, T min_key, uint64_t range, bool descending = false) {
+        std::vector<size_t> counts(static_cast<size_t>(range) + 1, 0);
+        const auto base = ordered_bits(min_key);
+        for (size_t i = 0; i < n; ++i) counts[static_cast<size_t>(ordered_bits(arr[i]) - base)]++;
+        size_t out = 0;
+        for (size_t k = 0; k <= range; ++k) {
+            const size_t bucket = descending ? static_cast<size_t>(range) - k : k;
+            const T value = static_cast<T>(min_key + static_cast<T>(bucket));
+            std::fill(arr + out, arr + out + counts[bucket], value);
+            out += counts[bucket];
+        }
+    }
+
+    /**
+     * LSD radix sort of integral keys, one byte per pass (stable within a
+     * pass). All byte histograms are built in a single read; passes where
+     * every key has the same byte are skipped. Needs an n-element buffer.
+     */
+    template<typename T>
+    void radix_sort(T* arr, size_t n, bool descending = false) {
+        using U = typename std::make_unsigned<T>::type;
+        constexpr size_t BYTES = sizeof(T);
+        std::vector<size_t> histogram(BYTES * 256, 0);
+        for (size_t i = 0; i < n; ++i) {
+            const U bits = ordered_bits(arr[i]);
+            for (size_t b = 0; b < BYTES; ++b) histogram[b * 256 + ((bits >> (8 * b)) & 0xFF)]++;
+        }
+
+        std::vector<T> buffer(n);
+        T* src = arr;
+        T* dst = buffer.data();
+        for (size_t b = 0; b < BYTES; ++b) {
+            size_t* counts = histogram.data() + b * 256;
+            const U first_byte = (ordered_bits(arr[0]) >> (8 * b)) & 0xFF;
+            if (counts[first_byte] == n) continue; // All keys share this byte
+            size_t offset = 0;
+            for (size_t k = 0; k < 256; ++k) {
+                const size_t count = counts[k];
+                counts[k] = offset;
+                offset += count;
+            }
+            for (size_t i = 0; i < n; ++i) {
+                const size_t digit = static_cast<size_t>((ordered_bits(src[i]) >> (8 * b)) & 0xFF);
+                dst[counts[digit]++] = src[i];
+            }
+            std::swap(src, dst);
+        }
+        if (src != arr) std::memcpy(arr, src, n * sizeof(T));
+        if (descending) std::reverse(arr, arr + n);
+    }
+
+    /**
+     * Sorts arr[0..n) with the algorithm choose_algorithm picks from
+     * analyze(arr, arr + n, comp). The result is always the stable order.
+     *
+     * @param arr Pointer to the array to sort.
+     * @param n Number of elements in the array.
+     * @param comp Strict weak ordering.
+     * @param table Decision thresholds (see SortDecisionTable).
+     * @return The algorithm that was used.
+     */
+    template<typename T, typename Compare>
+    SortAlgorithm sort(T* arr, size_t n, Compare comp, const SortDecisionTable& table = SortDecisionTable()) {
+        const Presortedness p = analyze(arr, arr + n, comp, table.sample_size);
+        const SortAlgorithm algorithm = choose_algorithm(p, table);
+        if (n < 2) return algorithm;
+
+        if constexpr (radix_sortable<T, Compare>::value) {
+            // std::greater<T> and std::greater<> sort descending
+            const bool descending = !comp(T(0), T(1));
+            switch (algorithm) {
+                case SortAlgorithm::Counting: {
+                    const T min_key = *std::min_element(arr, arr + n);
+                    counting_sort(arr, n, min_key, p.key_range, descending);
+                    return algorithm;
+                }
+                case SortAlgorithm::Radix:
+                    radix_sort(arr, n, descending);
+                    return algorithm;
+                case SortAlgorithm::Pdqsort:
+                    pdqsort_branchless(arr, arr + n, comp);
+                    return algorithm;
+                default:
+                    break;
+            }
+        }
+        block_merge_segment_sort(arr, n, BLOCK_MERGE_DEFAULT_BUFFER_SIZE, comp);
+        return SortAlgorithm::BlockMerge;
+    }
+
+    // Vector overload (std::less by default; see the pointer overload above).
+    template<typename T, typename Compare = std::less<T>>
+    SortAlgorithm sort(std::vector<T>& arr, Compare comp = Compare(), const SortDecisionTable& table = SortDecisionTable()) {
+        return segment_sort::sort(arr.data(), arr.size(), comp, table);
+    }
+}
+
+#endif // AUTO_SORT_HPP
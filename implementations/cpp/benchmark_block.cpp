@@ -5,8 +5,10 @@
 #include <random>
 #include <iomanip>
 #include <string>
+#include <numeric>
 
 #include "block_merge_segment_sort.h"
+#include "../../benchmarks/languages/cpp/perf_counters.h"
 
 using namespace std;
 using namespace std::chrono;
@@ -49,52 +51,65 @@ bool check_sorted(const vector<int>& arr) {
 
 // --- Benchmark Runner ---
 
-void run_benchmark(const string& name, void (*fill_func)(vector<int>&), size_t n) {
-    vector<int> arr(n);
-    vector<int> copy;
-    fill_func(arr);
+// Optional hardware counters (--perf); null when disabled or unavailable
+perf::CounterGroup* g_counters = nullptr;
 
-    int reps = 5;
-    if (name == "Sorted" || name == "Reverse") reps = 20;
-
-    cout << left << setw(15) << name << " | " << setw(8) << n << " | ";
+struct TimedResult {
+    double avg_ms = 0;
+    vector<perf::CounterValues> counters;
+};
 
-    // Block Merge
-    double total_block = 0;
+template<typename SortFn>
+TimedResult time_sort(const vector<int>& arr, int reps, SortFn sort_fn, const char* label) {
+    TimedResult result;
+    vector<int> copy;
+    double total = 0;
     for (int i = 0; i < reps; ++i) {
         copy = arr;
+        if (g_counters) g_counters->start();
         auto start = high_resolution_clock::now();
-        segment_sort::block_merge_segment_sort(copy);
+        sort_fn(copy);
         auto end = high_resolution_clock::now();
-        total_block += duration_cast<duration<double, milli>>(end - start).count();
+        if (g_counters) result.counters.push_back(g_counters->stop());
+        total += duration_cast<duration<double, milli>>(end - start).count();
         if (i == 0 && !check_sorted(copy)) {
-            cerr << "Block Merge Failed!" << endl;
+            cerr << label << " Failed!" << endl;
             exit(1);
         }
     }
-    double avg_block = total_block / reps;
+    result.avg_ms = total / reps;
+    return result;
+}
 
-    // std::sort
-    double total_std = 0;
-    for (int i = 0; i < reps; ++i) {
-        copy = arr;
-        auto start = high_resolution_clock::now();
-        sort(copy.begin(), copy.end());
-        auto end = high_resolution_clock::now();
-        total_std += duration_cast<duration<double, milli>>(end - start).count();
+void print_counters(const string& label, const TimedResult& r, size_t n) {
+    if (r.counters.empty() || !r.counters[0].any()) return;
+    double cycles = perf::medianCounter(r.counters, perf::CYCLES);
+    double instructions = perf::medianCounter(r.counters, perf::INSTRUCTIONS);
+    cout << "    " << left << setw(12) << label << right << fixed << setprecision(2);
+    if (cycles > 0) cout << " IPC " << instructions / cycles << " |";
+    for (int c = 0; c < perf::NUM_COUNTERS; ++c) {
+        if (!r.counters[0].valid[c]) continue;
+        cout << " " << perf::counterName(c) << "/elem " << perf::medianCounter(r.counters, c) / n;
     }
-    double avg_std = total_std / reps;
+    cout << endl;
+}
 
-    // std::stable_sort
-    double total_stable = 0;
-    for (int i = 0; i < reps; ++i) {
-        copy = arr;
-        auto start = high_resolution_clock::now();
-        stable_sort(copy.begin(), copy.end());
-        auto end = high_resolution_clock::now();
-        total_stable += duration_cast<duration<double, milli>>(end - start).count();
-    }
-    double avg_stable = total_stable / reps;
+void run_benchmark(const string& name, void (*fill_func)(vector<int>&), size_t n) {
+    vector<int> arr(n);
+    fill_func(arr);
+
+    int reps = 5;
+    if (name == "Sorted" || name == "Reverse") reps = 20;
+
+    cout << left << setw(15) << name << " | " << setw(8) << n << " | ";
+
+    TimedResult block = time_sort(arr, reps, [](vector<int>& a) { segment_sort::block_merge_segment_sort(a); }, "Block Merge");
+    TimedResult std_sort = time_sort(arr, reps, [](vector<int>& a) { sort(a.begin(), a.end()); }, "std::sort");
+    TimedResult stable = time_sort(arr, reps, [](vector<int>& a) { stable_sort(a.begin(), a.end()); }, "std::stable_sort");
+
+    double avg_block = block.avg_ms;
+    double avg_std = std_sort.avg_ms;
+    double avg_stable = stable.avg_ms;
 
     cout << fixed << setprecision(2) 
          << setw(10) << avg_block << " ms | "
@@ -106,18 +121,38 @@ void run_benchmark(const string& name, void (*fill_func)(vector<int>&), size_t n
     } else {
         cout << "\033[1;31mx" << avg_block / avg_std << " Slower\033[0m" << endl;
     }
+
+    print_counters("BlockMerge", block, n);
+    print_counters("std::sort", std_sort, n);
+    print_counters("std::stable", stable, n);
 }
 
 int main(int argc, char* argv[]) {
     size_t size = 1000000;
-    if (argc > 1) {
+    bool use_perf = false;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--perf") {
+            use_perf = true;
+            continue;
+        }
         try {
-            size = std::stoull(argv[1]);
+            size = std::stoull(arg);
         } catch (...) {
             std::cerr << "Invalid size argument. Using default: " << size << std::endl;
         }
     }
 
+    // Hardware counters degrade to wall-clock only when perf_event_open fails
+    perf::CounterGroup counters;
+    if (use_perf) {
+        if (counters.available()) {
+            g_counters = &counters;
+        } else {
+            cout << "[perf] Hardware counters unavailable (perf_event_open); wall-clock only" << endl;
+        }
+    }
+
     cout << "\n==========================================================================================" << endl;
     cout << "   C++ Benchmark: Block Merge Segment Sort vs std::sort vs std::stable_sort" << endl;
     cout << "==========================================================================================" << endl;
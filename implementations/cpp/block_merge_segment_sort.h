@@ -15,65 +15,285 @@
 #include <algorithm>
 #include <cmath>
 #include <iterator>
+#include <type_traits>
+#include <functional>
+#include <cstdint>
+#include "cache_info.h"
+#include "scratch_allocator.h"
+#include "sorting_network.h"
 
 // Fixed buffer size for optimal performance (fits in L2 cache).
 // 64K elements = 256KB for int arrays, 512KB for double arrays
 const size_t BLOCK_MERGE_DEFAULT_BUFFER_SIZE = 65536;
 
+// buffer_size values that size the buffer from the cache and sizeof(T)
+// instead (see auto_buffer_size). The _GROW variant may use up to n/2
+// elements when the machine has the memory to spare.
+const size_t BLOCK_MERGE_AUTO_BUFFER_SIZE = SIZE_MAX;
+const size_t BLOCK_MERGE_AUTO_GROW_BUFFER_SIZE = SIZE_MAX - 1;
+
+// Upper bound for the minimum run length (TimSort/PowerSort style).
+// Natural runs shorter than the computed min run are extended with insertion
+// sort before being pushed; 0 disables the extension.
+const size_t BLOCK_MERGE_DEFAULT_MIN_RUN = 32;
+
+// Block size of the sorting network pre-pass (power of two, 0 = off).
+// A natural run shorter than half a block is taken as a sign of random data:
+// the next block is sorted with sort_network<N> before the min run extension
+// (integral keys with std::less / std::greater only, see sorting_network.h).
+const size_t BLOCK_MERGE_DEFAULT_NETWORK_SIZE = 32;
+
+// Software prefetch hint (no-op on compilers without __builtin_prefetch)
+#if defined(__GNUC__) || defined(__clang__)
+#define SEGMENT_SORT_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define SEGMENT_SORT_PREFETCH(addr) ((void)0)
+#endif
+
+// How far ahead of each cursor the merge loops prefetch, in bytes (0 = off).
+// Off by default: both cursors stream sequentially, which hardware
+// prefetchers already follow (see BM_MergePrefetch in microbench_kernels).
+// Override with -DSEGMENT_SORT_PREFETCH_BYTES=N.
+#ifndef SEGMENT_SORT_PREFETCH_BYTES
+#define SEGMENT_SORT_PREFETCH_BYTES 0
+#endif
+const size_t BLOCK_MERGE_PREFETCH_BYTES = SEGMENT_SORT_PREFETCH_BYTES;
+
+// Merges whose runs both fit in the buffer go through merge_bidirectional
+// (trivially copyable types, neither run below a quarter of the merge).
+// -DSEGMENT_SORT_BIDIRECTIONAL_MERGE=0 keeps the forward-only merges.
+#ifndef SEGMENT_SORT_BIDIRECTIONAL_MERGE
+#define SEGMENT_SORT_BIDIRECTIONAL_MERGE 1
+#endif
+const bool BLOCK_MERGE_BIDIRECTIONAL = SEGMENT_SORT_BIDIRECTIONAL_MERGE != 0;
+
+// Internal instrumentation (comparisons, moves, merge strategies, ...).
+// Compiled in only with -DSEGMENT_SORT_STATS; otherwise every counter
+// statement expands to nothing and the SortStats* parameter is unused.
+#ifdef SEGMENT_SORT_STATS
+#define SEGMENT_SORT_STAT(stats, statement) do { if (stats) { statement; } } while (0)
+#else
+#define SEGMENT_SORT_STAT(stats, statement) do { (void)(stats); } while (0)
+#endif
+
 namespace segment_sort {
 
-    // Helper: Reverse a slice of the vector
+    // Number of log2 buckets in the run-length histogram
+    const size_t SORT_STATS_HISTOGRAM_BUCKETS = 64;
+
+    // True when the library was compiled with SEGMENT_SORT_STATS
+#ifdef SEGMENT_SORT_STATS
+    const bool SORT_STATS_ENABLED = true;
+#else
+    const bool SORT_STATS_ENABLED = false;
+#endif
+
+    /**
+     * Counters filled by block_merge_segment_sort when a SortStats* is passed
+     * and SEGMENT_SORT_STATS is defined. Useful to pick buffer_size per
+     * workload: a high symmerge_splits / rotated_elements share means the
+     * buffer is too small for the runs being merged.
+     */
+    struct SortStats {
+        uint64_t comparisons = 0;      // Calls to the comparator
+        uint64_t moves = 0;            // Element copies/moves (buffer, merge, rotate, reverse, insertion)
+        uint64_t buffer_merges = 0;    // Linear merges through the buffer
+        uint64_t block_merges = 0;     // In-place block merges (both sides larger than the buffer)
+        uint64_t network_sorts = 0;    // Blocks sorted by the sorting network pre-pass
+        uint64_t symmerge_splits = 0;  // SymMerge fallbacks (block merge not possible)
+        uint64_t skipped_merges = 0;   // Merges skipped because the runs were already in order
+        uint64_t rotations = 0;        // Rotations performed by SymMerge
+        uint64_t rotated_elements = 0; // Sum of rotation lengths
+        size_t max_rotation = 0;       // Longest single rotation
+        size_t max_recursion_depth = 0; // Deepest SymMerge recursion
+        size_t max_stack_depth = 0;    // Deepest run stack
+        size_t runs = 0;               // Natural runs detected
+        size_t buffer_elements = 0;    // Buffer limit used (after auto sizing)
+        size_t buffer_bytes = 0;       // buffer_elements * sizeof(T)
+        // run_length_histogram[k] = natural runs with length in [2^k, 2^(k+1))
+        uint64_t run_length_histogram[SORT_STATS_HISTOGRAM_BUCKETS] = {};
+    };
+
+    // Helper: floor(log2(x)) for x >= 1 (histogram bucket)
+    inline size_t log2_bucket(size_t x) {
+        size_t k = 0;
+        while (x >>= 1) ++k;
+        return k;
+    }
+
+    // Helper: Reverse a slice of the array
     template<typename T>
-    void reverse_slice(std::vector<T>& arr, size_t start, size_t end) {
-        std::reverse(arr.begin() + start, arr.begin() + end);
+    void reverse_slice(T* arr, size_t start, size_t end) {
+        std::reverse(arr + start, arr + end);
     }
 
     // Helper: Detect a sorted segment (run)
-    template<typename T>
-    size_t detect_segment(std::vector<T>& arr, size_t start) {
-        size_t n = arr.size();
+    // Descending runs must be strictly descending so that reversing them
+    // keeps equal elements in input order (stable).
+    template<typename T, typename Compare>
+    size_t detect_segment(T* arr, size_t start, size_t n, Compare comp, SortStats* stats = nullptr) {
         if (start >= n) return start;
 
         size_t end = start + 1;
         if (end >= n) return end;
 
-        if (arr[start] > arr[end]) {
+        if (comp(arr[end], arr[start])) {
             // Descending run
-            while (end < n && arr[end - 1] > arr[end]) {
+            while (end < n && comp(arr[end], arr[end - 1])) {
                 end++;
             }
             reverse_slice(arr, start, end);
+            SEGMENT_SORT_STAT(stats, stats->moves += end - start);
         } else {
             // Ascending run
-            while (end < n && arr[end - 1] <= arr[end]) {
+            while (end < n && !comp(arr[end], arr[end - 1])) {
                 end++;
             }
         }
         return end;
     }
 
+    // Helper: Compute the minimum run length for n elements (TimSort style).
+    // Returns n when n < max_min_run, otherwise a value in
+    // [max_min_run / 2, max_min_run] so that n / min_run is close to, but no
+    // greater than, a power of two (keeps the final merges balanced).
+    inline size_t compute_min_run(size_t n, size_t max_min_run) {
+        if (max_min_run == 0) return 0;
+        size_t r = 0;
+        while (n >= max_min_run) {
+            r |= n & 1;
+            n >>= 1;
+        }
+        return n + r;
+    }
+
+    // Helper: Binary insertion sort of [start, end), assuming [start, sorted_end)
+    // is already sorted. upper_bound keeps equal elements in input order (stable).
+    template<typename T, typename Compare>
+    void binary_insertion_sort(T* arr, size_t start, size_t sorted_end, size_t end, Compare comp, SortStats* stats = nullptr) {
+        for (size_t i = sorted_end; i < end; ++i) {
+            T pivot = std::move(arr[i]);
+            T* pos = std::upper_bound(arr + start, arr + i, pivot, comp);
+            std::move_backward(pos, arr + i, arr + i + 1);
+            *pos = std::move(pivot);
+            SEGMENT_SORT_STAT(stats, stats->moves += (arr + i - pos) + 2);
+        }
+    }
+
+    // Helper: Linear insertion sort of [start, end), assuming [start, sorted_end)
+    // is already sorted. Stops at the first element not greater than the pivot (stable).
+    template<typename T, typename Compare>
+    void insertion_sort(T* arr, size_t start, size_t sorted_end, size_t end, Compare comp, SortStats* stats = nullptr) {
+        for (size_t i = sorted_end; i < end; ++i) {
+            T pivot = std::move(arr[i]);
+            size_t j = i;
+            while (j > start && comp(pivot, arr[j - 1])) {
+                arr[j] = std::move(arr[j - 1]);
+                --j;
+            }
+            arr[j] = std::move(pivot);
+            SEGMENT_SORT_STAT(stats, stats->moves += (i - j) + 2);
+        }
+    }
+
+    // Helper: Extend the sorted run [start, sorted_end) to [start, end).
+    // Binary insertion minimizes comparisons for expensive types; for arithmetic
+    // types the data-dependent branches of the binary search cost more than the
+    // extra comparisons, so the linear scan is used instead.
+    template<typename T, typename Compare>
+    void extend_run(T* arr, size_t start, size_t sorted_end, size_t end, Compare comp, SortStats* stats = nullptr) {
+        if constexpr (std::is_arithmetic<T>::value) {
+            insertion_sort(arr, start, sorted_end, end, comp, stats);
+        } else {
+            binary_insertion_sort(arr, start, sorted_end, end, comp, stats);
+        }
+    }
+
     // Helper: Rotate range [first, middle, last)
     template<typename T>
-    void rotate_range(std::vector<T>& arr, size_t first, size_t middle, size_t last) {
-        std::rotate(arr.begin() + first, arr.begin() + middle, arr.begin() + last);
+    void rotate_range(T* arr, size_t first, size_t middle, size_t last) {
+        std::rotate(arr + first, arr + middle, arr + last);
     }
 
-    // Helper: Merge using buffer for left part
-    template<typename T>
-    void merge_with_buffer_left(std::vector<T>& arr, size_t first, size_t middle, size_t last, std::vector<T>& buffer) {
+    /**
+     * Helper: Rotate [first, middle, last) using the merge buffer.
+     * - Shorter side fits in buffer_limit: copy it out, shift the longer side
+     *   with one memmove-style move, copy it back (len + shorter moves).
+     * - Otherwise Gries-Mills block swaps: swap the shorter side with the
+     *   adjacent end of the longer one, which puts it in its final place,
+     *   and continue on the rest. Swaps stream through memory (unlike the
+     *   cycle walk of std::rotate), and the loop switches to the buffer as
+     *   soon as the remaining shorter side fits.
+     * With buffer_limit == 0 it is std::rotate.
+     */
+    template<typename T, typename Alloc>
+    void rotate_with_buffer(T* arr, size_t first, size_t middle, size_t last, std::vector<T, Alloc>& buffer,
+                            size_t buffer_limit, SortStats* stats = nullptr) {
+        if (buffer_limit == 0) {
+            // No buffer at all: block swaps alone lose to std::rotate
+            rotate_range(arr, first, middle, last);
+            SEGMENT_SORT_STAT(stats, stats->moves += last - first);
+            return;
+        }
+        while (first < middle && middle < last) {
+            size_t len1 = middle - first;
+            size_t len2 = last - middle;
+
+            if (std::min(len1, len2) <= buffer_limit) {
+                if (len1 <= len2) {
+                    if (buffer.size() < len1) buffer.resize(len1);
+                    std::copy(arr + first, arr + middle, buffer.begin());
+                    std::move(arr + middle, arr + last, arr + first);
+                    std::copy(buffer.begin(), buffer.begin() + len1, arr + first + len2);
+                } else {
+                    if (buffer.size() < len2) buffer.resize(len2);
+                    std::copy(arr + middle, arr + last, buffer.begin());
+                    std::move_backward(arr + first, arr + middle, arr + last);
+                    std::copy(buffer.begin(), buffer.begin() + len2, arr + first);
+                }
+                SEGMENT_SORT_STAT(stats, stats->moves += len1 + len2 + std::min(len1, len2));
+                return;
+            }
+
+            if (len1 <= len2) {
+                // A B1 B2 -> B1 A B2: B1 is final, rotate A B2
+                std::swap_ranges(arr + first, arr + middle, arr + middle);
+                SEGMENT_SORT_STAT(stats, stats->moves += 2 * len1);
+                first = middle;
+                middle += len1;
+            } else {
+                // A1 A2 B -> A1 B A2: A2 is final, rotate A1 B
+                std::swap_ranges(arr + middle - len2, arr + middle, arr + middle);
+                SEGMENT_SORT_STAT(stats, stats->moves += 2 * len2);
+                last = middle;
+                middle -= len2;
+            }
+        }
+    }
+
+    // Helper: Merge using buffer for left part.
+    // PrefetchBytes: prefetch distance ahead of both read cursors (0 = none)
+    template<size_t PrefetchBytes = BLOCK_MERGE_PREFETCH_BYTES, typename T, typename Compare, typename Alloc>
+    void merge_with_buffer_left(T* arr, size_t first, size_t middle, size_t last, std::vector<T, Alloc>& buffer, Compare comp,
+                                SortStats* stats = nullptr) {
         size_t len1 = middle - first;
         
         // Copy left to buffer
         // Ensure buffer is large enough (though caller checks this)
         if (buffer.size() < len1) buffer.resize(len1);
-        std::copy(arr.begin() + first, arr.begin() + middle, buffer.begin());
+        std::copy(arr + first, arr + middle, buffer.begin());
 
         size_t i = 0;      // buffer index
         size_t j = middle; // right part index
         size_t k = first;  // dest index
+        constexpr size_t d = PrefetchBytes / sizeof(T);
 
         while (i < len1 && j < last) {
-            if (buffer[i] <= arr[j]) {
+            if (d > 0) {
+                if (i + d < len1) SEGMENT_SORT_PREFETCH(buffer.data() + i + d);
+                if (j + d < last) SEGMENT_SORT_PREFETCH(arr + j + d);
+            }
+            if (!comp(arr[j], buffer[i])) {
                 arr[k++] = buffer[i++];
             } else {
                 arr[k++] = arr[j++];
@@ -82,23 +302,31 @@ namespace segment_sort {
         while (i < len1) {
             arr[k++] = buffer[i++];
         }
+        SEGMENT_SORT_STAT(stats, stats->moves += len1 + (k - first));
     }
 
-    // Helper: Merge using buffer for right part
-    template<typename T>
-    void merge_with_buffer_right(std::vector<T>& arr, size_t first, size_t middle, size_t last, std::vector<T>& buffer) {
+    // Helper: Merge using buffer for right part (walks both runs backwards,
+    // so the prefetches go to lower addresses)
+    template<size_t PrefetchBytes = BLOCK_MERGE_PREFETCH_BYTES, typename T, typename Compare, typename Alloc>
+    void merge_with_buffer_right(T* arr, size_t first, size_t middle, size_t last, std::vector<T, Alloc>& buffer, Compare comp,
+                                 SortStats* stats = nullptr) {
         size_t len2 = last - middle;
         
         // Copy right to buffer
         if (buffer.size() < len2) buffer.resize(len2);
-        std::copy(arr.begin() + middle, arr.begin() + last, buffer.begin());
+        std::copy(arr + middle, arr + last, buffer.begin());
 
         long i = (long)middle - 1; // left part index
         long j = (long)len2 - 1;   // buffer index
         long k = (long)last - 1;   // dest index
+        constexpr long d = (long)(PrefetchBytes / sizeof(T));
 
         while (i >= (long)first && j >= 0) {
-            if (arr[i] > buffer[j]) {
+            if (d > 0) {
+                if (i - d >= (long)first) SEGMENT_SORT_PREFETCH(arr + i - d);
+                if (j - d >= 0) SEGMENT_SORT_PREFETCH(buffer.data() + j - d);
+            }
+            if (comp(buffer[j], arr[i])) {
                 arr[k--] = arr[i--];
             } else {
                 arr[k--] = buffer[j--];
@@ -107,117 +335,623 @@ namespace segment_sort {
         while (j >= 0) {
             arr[k--] = buffer[j--];
         }
+        SEGMENT_SORT_STAT(stats, stats->moves += len2 + (size_t)((long)last - 1 - k));
+    }
+
+    /**
+     * Helper: Bidirectional merge (quadsort/blitsort parity merge). Both
+     * runs are copied to the buffer; then each step writes the smallest
+     * remaining element at the front and the largest at the back. The two
+     * ends are independent dependency chains, each step is branchless, and
+     * the loop runs min(len1, len2) times instead of len1 + len2. Reads
+     * stay inside the runs without bounds checks: after t < min(len1, len2)
+     * steps neither end can have used up a run. What is left in the middle
+     * (the surplus of the longer run) goes through a plain forward merge.
+     * Needs buffer room for len1 + len2 elements. Ties: front takes the
+     * left element, back the right one (stable).
+     */
+    template<typename T, typename Compare, typename Alloc>
+    void merge_bidirectional(T* arr, size_t first, size_t middle, size_t last, std::vector<T, Alloc>& buffer, Compare comp,
+                             SortStats* stats = nullptr) {
+        const size_t len1 = middle - first;
+        const size_t n = last - first;
+        if (buffer.size() < n) buffer.resize(n);
+        std::copy(arr + first, arr + last, buffer.begin());
+
+        const T* buf = buffer.data();
+        size_t l = 0, r = len1;               // front cursors
+        size_t l_tail = len1, r_tail = n;     // back cursors (one past)
+        T* out = arr + first;
+        T* out_tail = arr + last;
+
+        for (size_t steps = std::min(len1, n - len1); steps > 0; --steps) {
+            const bool front_right = comp(buf[r], buf[l]);
+            *out++ = buf[front_right ? r : l];
+            r += front_right;
+            l += !front_right;
+
+            const bool back_left = comp(buf[r_tail - 1], buf[l_tail - 1]);
+            *--out_tail = buf[back_left ? l_tail - 1 : r_tail - 1];
+            l_tail -= back_left;
+            r_tail -= !back_left;
+        }
+
+        while (l < l_tail && r < r_tail) {
+            const bool take_right = comp(buf[r], buf[l]);
+            *out++ = buf[take_right ? r : l];
+            r += take_right;
+            l += !take_right;
+        }
+        out = std::copy(buf + l, buf + l_tail, out);
+        std::copy(buf + r, buf + r_tail, out);
+        SEGMENT_SORT_STAT(stats, stats->moves += 2 * n);
+    }
+
+    /**
+     * Branchless lower_bound for the SymMerge split search. The loop always
+     * runs log2(n) steps and moves `base` with a conditional move instead of
+     * a hard-to-predict branch; both possible next probes are prefetched, so
+     * on ranges far larger than the LLC the misses of consecutive steps
+     * overlap.
+     */
+    template<typename T, typename Compare>
+    T* branchless_lower_bound(T* first, T* last, const T& value, Compare comp) {
+        size_t len = static_cast<size_t>(last - first);
+        if (len == 0) return first;
+        T* base = first;
+        while (len > 1) {
+            size_t half = len / 2;
+            size_t rest = len - half;
+            SEGMENT_SORT_PREFETCH(base + rest / 2);
+            SEGMENT_SORT_PREFETCH(base + half + rest / 2);
+            base = comp(base[half], value) ? base + half : base;
+            len = rest;
+        }
+        return base + (comp(*base, value) ? 1 : 0);
+    }
+
+    // Helper: Merge [first, middle) with [middle, last) through the internal
+    // buffer arr[buf, buf + (middle - first)), which lies outside the range.
+    // Swaps instead of copies, so the buffer keeps its elements (permuted).
+    template<typename T, typename Compare>
+    void merge_with_internal_buffer(T* arr, size_t first, size_t middle, size_t last, size_t buf, Compare comp,
+                                    SortStats* stats = nullptr) {
+        size_t len1 = middle - first;
+        std::swap_ranges(arr + first, arr + middle, arr + buf);
+
+        size_t i = buf;           // buffer index
+        size_t buf_end = buf + len1;
+        size_t j = middle;        // right part index
+        size_t k = first;         // dest index, always < j while the buffer is not empty
+
+        while (i < buf_end && j < last) {
+            if (!comp(arr[j], arr[i])) {
+                std::swap(arr[k++], arr[i++]);
+            } else {
+                std::swap(arr[k++], arr[j++]);
+            }
+        }
+        while (i < buf_end) {
+            std::swap(arr[k++], arr[i++]);
+        }
+        SEGMENT_SORT_STAT(stats, stats->moves += 2 * (len1 + (k - first)));
+    }
+
+    /**
+     * In-place block merge of [first, middle) with [middle, last) for when
+     * neither side fits in the buffer (WikiSort / GrailSort family):
+     * 1. Extract distinct keys from the start of the left run (first
+     *    occurrences, so they go back in front of their equals).
+     * 2. Split the rest of the left run into blocks of max(buffer_limit,
+     *    sqrt(len1)) elements and tag each block by swapping its first element
+     *    with a key; the tags record the original block order.
+     * 3. Roll the left blocks through the right run: a right block moves
+     *    before them while it ends below the smallest remaining left block,
+     *    otherwise that block (found by its tag) is dropped into the last
+     *    right block at its lower_bound.
+     * 4. Each dropped block is merged locally with the right elements that
+     *    follow it: through the buffer when a block fits in it, otherwise by
+     *    swaps through a second set of keys used as an internal buffer.
+     * 5. Sort the internal buffer keys and rotate every key back into place.
+     * Linear moves and comparisons plus O(sqrt(len1)^2) for the keys, with no
+     * memory beyond buffer_limit. Returns false, without touching the range,
+     * when the left run has too few distinct values: the caller falls back to
+     * SymMerge.
+     */
+    template<typename T, typename Compare, typename Alloc>
+    bool block_merge_in_place(T* arr, size_t first, size_t middle, size_t last, std::vector<T, Alloc>& buffer,
+                              size_t buffer_limit, Compare comp, SortStats* stats = nullptr) {
+        size_t len1 = middle - first;
+        size_t root = static_cast<size_t>(std::sqrt(static_cast<double>(len1)));
+        bool internal = buffer_limit < root;
+        size_t block = internal ? root : buffer_limit;
+        size_t tags = len1 / block;
+        size_t wanted = tags + (internal ? block : 0);
+        if (tags == 0 || 2 * wanted > len1) return false;
+
+        // 1. Enough distinct values?
+        size_t distinct = 1;
+        for (size_t i = first + 1; i < middle && distinct < wanted; ++i) {
+            if (comp(arr[i - 1], arr[i])) distinct++;
+        }
+        if (distinct < wanted) return false;
+        SEGMENT_SORT_STAT(stats, stats->block_merges++);
+
+        // Gather the first `wanted` distinct values into a block that travels
+        // right, then rotate it to the front: [keys | rest of left | right]
+        size_t keys = first;
+        size_t count = 1;
+        for (size_t i = first + 1; count < wanted; ++i) {
+            if (comp(arr[keys + count - 1], arr[i])) {
+                if (keys + count != i) {
+                    rotate_with_buffer(arr, keys, keys + count, i, buffer, buffer_limit, stats);
+                    keys = i - count;
+                }
+                count++;
+            }
+        }
+        rotate_with_buffer(arr, first, keys, keys + wanted, buffer, buffer_limit, stats);
+
+        const size_t tag_keys = first;        // [first, first + tags)
+        const size_t buf = first + tags;      // [buf, buf + block) when internal
+        const size_t start = first + wanted;  // rest of the left run
+
+        // 2. Uneven first block stays put; tag the full blocks
+        size_t window = start + (middle - start) % block;  // rolling left blocks
+        size_t window_end = middle;
+        for (size_t b = window, t = tag_keys; b < window_end; b += block, ++t) {
+            std::swap(arr[b], arr[t]);
+        }
+        SEGMENT_SORT_STAT(stats, stats->moves += 2 * tags);
+
+        auto local_merge = [&](size_t a, size_t m, size_t e) {
+            if (a == m || m == e || !comp(arr[m], arr[m - 1])) return;
+            if (internal) {
+                merge_with_internal_buffer(arr, a, m, e, buf, comp, stats);
+            } else {
+                merge_with_buffer_left(arr, a, m, e, buffer, comp, stats);
+            }
+        };
+
+        // 3./4. Roll and drop
+        size_t last_a = start, last_a_end = window;   // previous left block, not yet merged
+        size_t last_b = window;                       // last right block: [last_b, window)
+        size_t block_b = middle;                      // next right block
+        size_t block_b_end = middle + std::min(block, last - middle);
+        size_t min_a = window;                        // smallest remaining left block
+        size_t index_a = tag_keys;                    // its real first value
+
+        while (true) {
+            if ((last_b < window && !comp(arr[window - 1], arr[index_a])) || block_b == block_b_end) {
+                // Drop the smallest left block into the last right block
+                size_t split = branchless_lower_bound(arr + last_b, arr + window, arr[index_a], comp) - arr;
+                if (min_a != window) {
+                    std::swap_ranges(arr + window, arr + window + block, arr + min_a);
+                    SEGMENT_SORT_STAT(stats, stats->moves += 2 * block);
+                }
+                std::swap(arr[window], arr[index_a++]);
+
+                local_merge(last_a, last_a_end, split);
+                rotate_with_buffer(arr, split, window, window + block, buffer, buffer_limit, stats);
+
+                last_a = split;
+                last_a_end = split + block;
+                last_b = last_a_end;
+                window += block;
+                if (window == window_end) break;
+
+                min_a = window;
+                for (size_t b = window + block; b < window_end; b += block) {
+                    if (comp(arr[b], arr[min_a])) min_a = b;
+                }
+            } else if (block_b_end - block_b < block) {
+                // Uneven last right block: rotate it in front of the left blocks
+                size_t len = block_b_end - block_b;
+                rotate_with_buffer(arr, window, block_b, block_b_end, buffer, buffer_limit, stats);
+                last_b = window;
+                window += len;
+                window_end += len;
+                min_a += len;
+                block_b = block_b_end;
+            } else {
+                // Swap the first left block with the next right block
+                std::swap_ranges(arr + window, arr + window + block, arr + block_b);
+                SEGMENT_SORT_STAT(stats, stats->moves += 2 * block);
+                if (min_a == window) min_a = window_end;
+                last_b = window;
+                window += block;
+                window_end += block;
+                block_b += block;
+                block_b_end = std::min(block_b_end + block, last);
+            }
+        }
+        local_merge(last_a, last_a_end, last);
+
+        // 5. The tag keys are back in order; the internal buffer keys are
+        // distinct, so any sort restores them
+        if (internal) std::sort(arr + buf, arr + buf + block, comp);
+
+        // Each key goes in front of its equals: rotate the key block up to
+        // the lower_bound of its first key, which is then final
+        size_t key = first;
+        size_t remaining = wanted;
+        while (remaining > 0) {
+            size_t pos = branchless_lower_bound(arr + key + remaining, arr + last, arr[key], comp) - arr;
+            if (pos != key + remaining) {
+                rotate_with_buffer(arr, key, key + remaining, pos, buffer, buffer_limit, stats);
+                key = pos - remaining;
+            }
+            key++;
+            remaining--;
+        }
+        return true;
     }
 
     // Core: Buffered Merge (Hybrid)
-    template<typename T>
-    void buffered_merge(std::vector<T>& arr, size_t first, size_t middle, size_t last, std::vector<T>& buffer, size_t buffer_limit) {
+    // depth is the SymMerge recursion depth (only tracked for stats).
+    // InPlaceBlockMerge: try block_merge_in_place before SymMerge when
+    // neither side fits in the buffer (false keeps the pure SymMerge path).
+    // Bidirectional: use merge_bidirectional when both runs fit.
+    template<bool InPlaceBlockMerge = true, bool Bidirectional = BLOCK_MERGE_BIDIRECTIONAL,
+             typename T, typename Compare, typename Alloc>
+    void buffered_merge(T* arr, size_t first, size_t middle, size_t last, std::vector<T, Alloc>& buffer, size_t buffer_limit, Compare comp,
+                        SortStats* stats = nullptr, size_t depth = 0) {
         if (first >= middle || middle >= last) return;
 
         size_t len1 = middle - first;
         size_t len2 = last - middle;
+        SEGMENT_SORT_STAT(stats, stats->max_recursion_depth = std::max(stats->max_recursion_depth, depth));
 
         // Optimization: Already sorted?
-        if (arr[middle - 1] <= arr[middle]) return;
+        if (!comp(arr[middle], arr[middle - 1])) {
+            SEGMENT_SORT_STAT(stats, stats->skipped_merges++);
+            return;
+        }
 
-        // Strategy 1: Use buffer if small enough
+        // Trim what is already in place: left elements not above the first
+        // right one, right elements not below the last left one
+        first = std::upper_bound(arr + first, arr + middle, arr[middle], comp) - arr;
+        last = branchless_lower_bound(arr + middle, arr + last, arr[middle - 1], comp) - arr;
+        len1 = middle - first;
+        len2 = last - middle;
+
+        // Strategy 1: Use buffer if small enough. Both runs fit, neither is
+        // below a quarter of the merge and copies are cheap: merge from both
+        // ends (copying both runs costs more than the branch misses it saves
+        // for types like std::string)
+        if (Bidirectional && std::is_trivially_copyable<T>::value && len1 + len2 <= buffer_limit &&
+            4 * std::min(len1, len2) >= len1 + len2) {
+            SEGMENT_SORT_STAT(stats, stats->buffer_merges++);
+            merge_bidirectional(arr, first, middle, last, buffer, comp, stats);
+            return;
+        }
         if (len1 <= buffer_limit) {
-            merge_with_buffer_left(arr, first, middle, last, buffer);
+            SEGMENT_SORT_STAT(stats, stats->buffer_merges++);
+            merge_with_buffer_left(arr, first, middle, last, buffer, comp, stats);
             return;
         }
         if (len2 <= buffer_limit) {
-            merge_with_buffer_right(arr, first, middle, last, buffer);
+            SEGMENT_SORT_STAT(stats, stats->buffer_merges++);
+            merge_with_buffer_right(arr, first, middle, last, buffer, comp, stats);
             return;
         }
 
-        // Strategy 2: SymMerge (Divide and Conquer)
+        // Strategy 2: In-place block merge (linear, needs distinct keys)
+        if (InPlaceBlockMerge && block_merge_in_place(arr, first, middle, last, buffer, buffer_limit, comp, stats)) {
+            return;
+        }
+        SEGMENT_SORT_STAT(stats, stats->symmerge_splits++);
+
+        // Strategy 3: SymMerge (Divide and Conquer)
         size_t mid1 = first + (middle - first) / 2;
         const T& value = arr[mid1];
         
-        auto it = std::lower_bound(arr.begin() + middle, arr.begin() + last, value);
-        size_t mid2 = std::distance(arr.begin(), it);
+        T* it = branchless_lower_bound(arr + middle, arr + last, value, comp);
+        size_t mid2 = it - arr;
 
         size_t newMid = mid1 + (mid2 - middle);
 
-        rotate_range(arr, mid1, middle, mid2);
+        rotate_with_buffer(arr, mid1, middle, mid2, buffer, buffer_limit, stats);
+        SEGMENT_SORT_STAT(stats, {
+            size_t rotated = mid2 - mid1;
+            stats->rotations++;
+            stats->rotated_elements += rotated;
+            stats->max_rotation = std::max(stats->max_rotation, rotated);
+        });
 
-        buffered_merge(arr, first, mid1, newMid, buffer, buffer_limit);
-        buffered_merge(arr, newMid + 1, mid2, last, buffer, buffer_limit);
+        buffered_merge<InPlaceBlockMerge, Bidirectional>(arr, first, mid1, newMid, buffer, buffer_limit, comp, stats, depth + 1);
+        buffered_merge<InPlaceBlockMerge, Bidirectional>(arr, newMid + 1, mid2, last, buffer, buffer_limit, comp, stats, depth + 1);
     }
 
+    // Run on the merge stack. `power` is only used by PowerSortMergePolicy
+    // (node power of the boundary between this run and the next one).
+    struct Segment {
+        size_t start;
+        size_t end;
+        unsigned power;
+    };
+
     /**
-     * @brief Block Merge Segment Sort (C++ Implementation)
-     * 
-     * A hybrid adaptive sorting algorithm that combines:
-     * 1. "On-the-Fly" Segment Detection (O(N) for sorted data)
-     * 2. Block Merge Strategy (Linear time merge using small buffer)
-     * 
-     * @details
-     * This algorithm detects sorted segments and merges them using a stack-based
-     * approach to maintain balance. It uses a fixed 64K element buffer (256KB for int)
-     * to perform fast linear-time merges. If segments are too large for the buffer,
-     * it falls back to a rotation-based in-place merge (SymMerge) to split them.
-     * 
-     * Complexity:
-     * - Time: O(N log N) worst case, O(N) best case (sorted/reverse).
-     * - Space: O(1) - fixed 256KB buffer + O(log N) stack.
-     * 
-     * @tparam T Type of elements to sort (must be comparable).
-     * @param arr Vector to sort.
-     * @param buffer_size Size of the merge buffer (default 65536).
+     * Merge policies decide which adjacent runs on the stack are merged when a
+     * new run arrives. Each policy exposes:
+     *
+     *   template<typename MergeFn>
+     *   static void push_run(std::vector<Segment>& stack, Segment run, size_t n, MergeFn merge);
+     *
+     * where merge(a, b) merges two adjacent segments and returns the result.
+     * Whatever remains on the stack after the last run is merged top-down.
+     */
+
+    // Original rule: merge while the current run is at least as long as the top.
+    struct BalancedMergePolicy {
+        template<typename MergeFn>
+        static void push_run(std::vector<Segment>& stack, Segment run, size_t, MergeFn merge) {
+            while (!stack.empty() && run.end - run.start >= stack.back().end - stack.back().start) {
+                run = merge(stack.back(), run);
+                stack.pop_back();
+            }
+            stack.push_back(run);
+        }
+    };
+
+    // TimSort invariants (with the 4-run check from de Gouw et al. 2015):
+    // |X| > |Y| + |Z| and |Y| > |Z| for the topmost runs X, Y, Z.
+    struct TimSortMergePolicy {
+        template<typename MergeFn>
+        static void push_run(std::vector<Segment>& stack, Segment run, size_t, MergeFn merge) {
+            auto len = [&stack](size_t k) { return stack[k].end - stack[k].start; };
+            auto merge_at = [&](size_t k) {
+                stack[k] = merge(stack[k], stack[k + 1]);
+                stack.erase(stack.begin() + k + 1);
+            };
+
+            stack.push_back(run);
+            while (stack.size() > 1) {
+                size_t k = stack.size() - 2;
+                if ((k > 0 && len(k - 1) <= len(k) + len(k + 1)) ||
+                    (k > 1 && len(k - 2) <= len(k - 1) + len(k))) {
+                    if (len(k - 1) < len(k + 1)) --k;
+                } else if (len(k) > len(k + 1)) {
+                    break;
+                }
+                merge_at(k);
+            }
+        }
+    };
+
+    // Helper: PowerSort node power of the boundary between runs [begin_a, begin_b)
+    // and [begin_b, end_b) in an array of n elements (Munro & Wild 2018).
+    // Counts the common leading bits of the two run midpoints scaled to [0, 1);
+    // bitwise version, exact and overflow-free for any n.
+    inline unsigned node_power(size_t n, size_t begin_a, size_t begin_b, size_t end_b) {
+        size_t l = begin_a + begin_b; // 2 * midpoint of A
+        size_t r = begin_b + end_b;   // 2 * midpoint of B
+        unsigned common_bits = 0;
+        bool digit_a = l >= n, digit_b = r >= n;
+        while (digit_a == digit_b) {
+            ++common_bits;
+            if (digit_a) {
+                l -= n;
+                r -= n;
+            }
+            l *= 2;
+            r *= 2;
+            digit_a = l >= n;
+            digit_b = r >= n;
+        }
+        return common_bits + 1;
+    }
+
+    // PowerSort: merge while the power of the top boundary exceeds the power of
+    // the boundary with the new run. Provably within O(n) of optimal merge cost.
+    struct PowerSortMergePolicy {
+        template<typename MergeFn>
+        static void push_run(std::vector<Segment>& stack, Segment run, size_t n, MergeFn merge) {
+            if (!stack.empty()) {
+                Segment a = stack.back();
+                stack.pop_back();
+                unsigned power = node_power(n, a.start, run.start, run.end);
+                while (!stack.empty() && stack.back().power > power) {
+                    a = merge(stack.back(), a);
+                    stack.pop_back();
+                }
+                a.power = power;
+                stack.push_back(a);
+            }
+            stack.push_back(run);
+        }
+    };
+
+    /**
+     * Merge buffer size, in elements, for sorting n elements of type T:
+     * - half of L2 in bytes (buffer plus the runs it merges stay near L2),
+     *   so the element count shrinks as sizeof(T) grows
+     * - n/2 when those n/2 elements fit in half of L3: no merge ever falls
+     *   back to SymMerge and the sort still runs out of cache
+     * - with grow, n/2 whenever it takes at most a quarter of the available
+     *   physical memory
+     * The result is never above ceil(n/2): the smaller side of any merge
+     * fits in that, so a larger buffer would only reserve memory.
      */
     template<typename T>
-    void block_merge_segment_sort(std::vector<T>& arr, size_t buffer_size = BLOCK_MERGE_DEFAULT_BUFFER_SIZE) {
-        size_t n = arr.size();
-        if (n <= 1) return;
+    size_t auto_buffer_size(size_t n, bool grow = false) {
+        const CacheInfo& cache = cache_info();
+        size_t elements = std::max<size_t>(cache.l2 / 2 / sizeof(T), 64);
+        size_t half = (n + 1) / 2;
+        if (half > elements) {
+            size_t half_bytes = half * sizeof(T);
+            size_t available = grow ? available_memory_bytes() : 0;
+            if (half_bytes <= cache.l3 / 2 || (available != 0 && half_bytes <= available / 4)) {
+                elements = half;
+            }
+        }
+        return std::min(elements, half);
+    }
 
-        // Reusable buffer
-        std::vector<T> buffer;
-        buffer.reserve(buffer_size);
+    // Resolves the BLOCK_MERGE_AUTO_* sentinels; other sizes are kept as given
+    template<typename T>
+    size_t resolve_buffer_size(size_t n, size_t buffer_size) {
+        if (buffer_size == BLOCK_MERGE_AUTO_BUFFER_SIZE) return auto_buffer_size<T>(n, false);
+        if (buffer_size == BLOCK_MERGE_AUTO_GROW_BUFFER_SIZE) return auto_buffer_size<T>(n, true);
+        return buffer_size;
+    }
+
+    template<size_t MinRun, typename MergePolicy, size_t NetworkSize, typename T, typename Compare>
+    void block_merge_segment_sort_impl(T* arr, size_t n, size_t buffer_size, Compare comp, SortStats* stats,
+                                       ScratchPolicy scratch_policy) {
+        const size_t min_run = compute_min_run(n, MinRun);
+        buffer_size = resolve_buffer_size<T>(n, buffer_size);
+        SEGMENT_SORT_STAT(stats, {
+            stats->buffer_elements = buffer_size;
+            stats->buffer_bytes = buffer_size * sizeof(T);
+        });
+
+        // Reusable buffer (a merge never copies more than n elements)
+        std::vector<T, ScratchAllocator<T>> buffer{ScratchAllocator<T>(scratch_policy)};
+        buffer.reserve(std::min(buffer_size, n));
 
-        struct Segment { size_t start; size_t end; };
         std::vector<Segment> stack;
         stack.reserve(64); // Log N depth
 
+        auto merge = [&](const Segment& a, const Segment& b) {
+            buffered_merge(arr, a.start, b.start, b.end, buffer, buffer_size, comp, stats);
+            return Segment{a.start, b.end, 0};
+        };
+
+        // Set while natural runs keep coming out shorter than NetworkSize / 2
+        bool disordered = false;
+
         size_t i = 0;
         while (i < n) {
             // 1. Detect next run (ascending or descending)
-            size_t end = detect_segment(arr, i);
-            
-            size_t current_start = i;
-            size_t current_end = end;
-            i = end;
-
-            // 2. Balance the stack (maintain invariant)
-            while (!stack.empty()) {
-                Segment top = stack.back();
-                size_t top_len = top.end - top.start;
-                size_t current_len = current_end - current_start;
-
-                // Invariant: Merge if current segment is larger or equal to top
-                if (current_len < top_len) {
-                    break;
+            size_t end = detect_segment(arr, i, n, comp, stats);
+            SEGMENT_SORT_STAT(stats, {
+                stats->runs++;
+                stats->run_length_histogram[log2_bucket(end - i)]++;
+            });
+
+            // Extend short runs to min_run with insertion sort
+            if (end - i < min_run && end < n) {
+                size_t forced_end = std::min(n, i + min_run);
+                if constexpr (NetworkSize > 0) {
+                    // High disorder (this run and the previous one are short):
+                    // sort a whole block with the network first. A single
+                    // short run, such as one out-of-place element in nearly
+                    // sorted data, still goes to insertion sort.
+                    const bool short_run = end - i < NetworkSize / 2;
+                    if (short_run && disordered && i + NetworkSize <= n) {
+                        sort_network<NetworkSize>(arr + i, comp);
+                        end = i + NetworkSize;
+                        forced_end = std::max(forced_end, end);
+                        SEGMENT_SORT_STAT(stats, {
+                            stats->network_sorts++;
+                            stats->moves += 2 * sorting_network_size(NetworkSize);
+                        });
+                    }
+                    disordered = short_run;
                 }
-
-                // Merge top and current
-                stack.pop_back();
-                buffered_merge(arr, top.start, current_start, current_end, buffer, buffer_size);
-                
-                current_start = top.start;
+                extend_run(arr, i, end, forced_end, comp, stats);
+                end = forced_end;
+            } else {
+                // A natural run of min_run or more ends the streak of short runs
+                disordered = false;
             }
 
-            // 3. Push new segment
-            stack.push_back({current_start, current_end});
+            // 2. Push the run, merging as dictated by the policy
+            MergePolicy::push_run(stack, Segment{i, end, 0}, n, merge);
+            SEGMENT_SORT_STAT(stats, stats->max_stack_depth = std::max(stats->max_stack_depth, stack.size()));
+            i = end;
         }
 
-        // 4. Force merge remaining segments
+        // 3. Force merge remaining segments
         while (stack.size() > 1) {
             Segment b = stack.back(); stack.pop_back();
             Segment a = stack.back(); stack.pop_back();
+            stack.push_back(merge(a, b));
+        }
+    }
+
+    /**
+     * @brief Block Merge Segment Sort (C++ Implementation)
+     * 
+     * A hybrid adaptive sorting algorithm that combines:
+     * 1. "On-the-Fly" Segment Detection (O(N) for sorted data)
+     * 2. Block Merge Strategy (Linear time merge using small buffer)
+     * 
+     * @details
+     * This algorithm detects sorted segments and merges them using a stack-based
+     * approach to maintain balance. It uses a fixed 64K element buffer (256KB for int)
+     * to perform fast linear-time merges. If segments are too large for the buffer,
+     * it merges them in place with internal key buffers (block_merge_in_place),
+     * or, when the left run has too few distinct values, with a rotation-based
+     * in-place merge (SymMerge) that splits them.
+     * 
+     * Natural runs shorter than the computed min run (see compute_min_run) are
+     * extended with (binary) insertion sort before being pushed, so random input
+     * starts merging from runs of MinRun/2..MinRun elements instead of ~2.
+     * For integral keys under std::less / std::greater, a run shorter than
+     * NetworkSize / 2 first has its whole NetworkSize block sorted by a
+     * branch-free sorting network (sort_network), and insertion sort only
+     * adds what is left up to the min run.
+     * 
+     * Complexity:
+     * - Time: O(N log N) worst case, O(N) best case (sorted/reverse).
+     * - Space: O(1) - fixed 256KB buffer + O(log N) stack (the AUTO sizes
+     *   scale the buffer with the cache, or with n for the _GROW variant).
+     * 
+     * @tparam MinRun Upper bound for the min run length (0 disables extension).
+     * @tparam MergePolicy Stack merge rule: BalancedMergePolicy (default),
+     *         TimSortMergePolicy or PowerSortMergePolicy.
+     * @tparam NetworkSize Sorting network block size (power of two, 0 disables
+     *         the pre-pass; ignored when MinRun is 0 or the key type does not
+     *         qualify, see network_sortable).
+     * @tparam T Type of elements to sort.
+     * @tparam Compare Strict weak ordering (std::less<T> for the vector overload).
+     * @param arr Pointer to the array to sort.
+     * @param n Number of elements in the array.
+     * @param buffer_size Size of the merge buffer in elements (default 65536),
+     *        or BLOCK_MERGE_AUTO_BUFFER_SIZE / BLOCK_MERGE_AUTO_GROW_BUFFER_SIZE
+     *        to size it from the cache (see auto_buffer_size).
+     * @param comp Comparison function object.
+     * @param stats Optional counters (reset on entry); only filled when
+     *        compiled with SEGMENT_SORT_STATS.
+     * @param scratch_policy ScratchPolicy flags for the merge buffer
+     *        (huge pages, NUMA-local placement; see scratch_allocator.h).
+     */
+    template<size_t MinRun = BLOCK_MERGE_DEFAULT_MIN_RUN,
+             typename MergePolicy = BalancedMergePolicy,
+             size_t NetworkSize = BLOCK_MERGE_DEFAULT_NETWORK_SIZE,
+             typename T, typename Compare>
+    void block_merge_segment_sort(T* arr, size_t n, size_t buffer_size, Compare comp, SortStats* stats = nullptr,
+                                  ScratchPolicy scratch_policy = SCRATCH_DEFAULT) {
+        if (stats) *stats = SortStats();
+        if (n <= 1) return;
 
-            buffered_merge(arr, a.start, b.start, b.end, buffer, buffer_size);
-            stack.push_back({a.start, b.end});
+        // Decided on the caller's comparator (the stats wrapper below is a lambda)
+        constexpr size_t network_size = network_sortable<T, Compare>::value ? NetworkSize : 0;
+
+#ifdef SEGMENT_SORT_STATS
+        if (stats) {
+            // Count comparisons by wrapping the comparator (only in stats builds)
+            auto counted = [&comp, stats](const T& a, const T& b) {
+                stats->comparisons++;
+                return comp(a, b);
+            };
+            block_merge_segment_sort_impl<MinRun, MergePolicy, network_size>(arr, n, buffer_size, counted, stats, scratch_policy);
+            return;
         }
+#endif
+        block_merge_segment_sort_impl<MinRun, MergePolicy, network_size>(arr, n, buffer_size, comp, stats, scratch_policy);
+    }
+
+    // Vector overload using operator< (see the pointer overload above).
+    template<size_t MinRun = BLOCK_MERGE_DEFAULT_MIN_RUN,
+             typename MergePolicy = BalancedMergePolicy,
+             size_t NetworkSize = BLOCK_MERGE_DEFAULT_NETWORK_SIZE,
+             typename T>
+    void block_merge_segment_sort(std::vector<T>& arr, size_t buffer_size = BLOCK_MERGE_DEFAULT_BUFFER_SIZE,
+                                  SortStats* stats = nullptr) {
+        block_merge_segment_sort<MinRun, MergePolicy, NetworkSize>(arr.data(), arr.size(), buffer_size, std::less<T>(), stats);
     }
 }
 
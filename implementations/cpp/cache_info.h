@@ -0,0 +1,115 @@
+/**
+ * Cache and Memory Detection - C++ Implementation
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Reads the data cache sizes once per process, used by the automatic merge
+ * buffer sizing of block_merge_segment_sort:
+ * - Linux: sysconf(_SC_LEVEL*_CACHE_SIZE), then
+ *   /sys/devices/system/cpu/cpu0/cache/index* for whatever sysconf left at 0
+ *   (musl and some containers report nothing through sysconf)
+ * - Elsewhere, or when nothing is reported: 32KB L1d, 256KB L2, 8MB L3
+ */
+
+#ifndef SEGMENT_SORT_CACHE_INFO_HPP
+#define SEGMENT_SORT_CACHE_INFO_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace segment_sort {
+
+    // Cache sizes in bytes. `detected` is false when any level fell back to
+    // the defaults.
+    struct CacheInfo {
+        size_t l1d = 0;
+        size_t l2 = 0;
+        size_t l3 = 0;
+        bool detected = false;
+    };
+
+    namespace detail {
+
+#if defined(__linux__)
+        // sysfs sizes look like "48K", "2048K" or "8M"
+        inline size_t read_sysfs_cache_size(const std::string& dir) {
+            std::ifstream file(dir + "/size");
+            std::string text;
+            if (!(file >> text) || text.empty()) return 0;
+            char* end = nullptr;
+            size_t value = std::strtoull(text.c_str(), &end, 10);
+            if (*end == 'K') value <<= 10;
+            else if (*end == 'M') value <<= 20;
+            else if (*end == 'G') value <<= 30;
+            return value;
+        }
+
+        inline void read_sysfs_cache_info(CacheInfo& info) {
+            const std::string base = "/sys/devices/system/cpu/cpu0/cache/index";
+            for (int index = 0; index < 16; ++index) {
+                const std::string dir = base + std::to_string(index);
+                std::ifstream level_file(dir + "/level");
+                std::ifstream type_file(dir + "/type");
+                int level = 0;
+                std::string type;
+                if (!(level_file >> level) || !(type_file >> type)) break;
+                if (type == "Instruction") continue;
+
+                size_t size = read_sysfs_cache_size(dir);
+                if (level == 1 && info.l1d == 0) info.l1d = size;
+                else if (level == 2 && info.l2 == 0) info.l2 = size;
+                else if (level == 3 && info.l3 == 0) info.l3 = size;
+            }
+        }
+
+        inline size_t sysconf_size(int name) {
+            long value = sysconf(name);
+            return value > 0 ? static_cast<size_t>(value) : 0;
+        }
+#endif
+
+        inline CacheInfo detect_cache_info() {
+            CacheInfo info;
+#if defined(__linux__)
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+            info.l1d = sysconf_size(_SC_LEVEL1_DCACHE_SIZE);
+            info.l2 = sysconf_size(_SC_LEVEL2_CACHE_SIZE);
+            info.l3 = sysconf_size(_SC_LEVEL3_CACHE_SIZE);
+#endif
+            if (info.l1d == 0 || info.l2 == 0 || info.l3 == 0) read_sysfs_cache_info(info);
+#endif
+            info.detected = info.l1d != 0 && info.l2 != 0 && info.l3 != 0;
+            if (info.l1d == 0) info.l1d = size_t(32) << 10;
+            if (info.l2 == 0) info.l2 = size_t(256) << 10;
+            if (info.l3 == 0) info.l3 = std::max(info.l2, size_t(8) << 20);
+            return info;
+        }
+
+    } // namespace detail
+
+    // Cache sizes of the running machine (detected on first call)
+    inline const CacheInfo& cache_info() {
+        static const CacheInfo info = detail::detect_cache_info();
+        return info;
+    }
+
+    // Physical memory currently available, in bytes (0 if unknown)
+    inline size_t available_memory_bytes() {
+#if defined(__linux__) && defined(_SC_AVPHYS_PAGES)
+        long pages = sysconf(_SC_AVPHYS_PAGES);
+        long page_size = sysconf(_SC_PAGESIZE);
+        if (pages > 0 && page_size > 0) return static_cast<size_t>(pages) * static_cast<size_t>(page_size);
+#endif
+        return 0;
+    }
+
+} // namespace segment_sort
+
+#endif // SEGMENT_SORT_CACHE_INFO_HPP
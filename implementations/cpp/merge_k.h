@@ -0,0 +1,445 @@
+/**
+ * K-Way Merge of Sorted Inputs - C++ Implementation
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Merges K already sorted arrays (shards, per-thread results, files read
+ * into memory) into one output without sorting them again:
+ *
+ * - merge_k replays a loser tree: each output element costs log2(K)
+ *   comparisons against the losers stored on the winner's path, instead of
+ *   the ~2 log2(K) of a binary heap sift-down.
+ * - When the same input wins GallopThreshold times in a row, the rest of
+ *   its block that precedes the runner-up is found by exponential search
+ *   and copied in bulk.
+ * - parallel_merge_k splits the output into equal slices. The input split
+ *   points of every slice boundary are found by co-ranking (multi-sequence
+ *   selection), and each thread merges its slice independently.
+ *
+ * The merge is stable: equal elements come out in input order (all of
+ * inputs[0] first, then inputs[1], ...), and in their order inside each
+ * input. Inputs are described by SortedSpan (pointer + length). Under
+ * C++20 the std::span overloads accept std::span<const std::span<const T>>.
+ */
+
+#ifndef MERGE_K_HPP
+#define MERGE_K_HPP
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <type_traits>
+
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+#include "block_merge_segment_sort.h"
+
+// Consecutive wins of one input before merge_k switches to a bulk copy (0 = off)
+const size_t MERGE_K_GALLOP_THRESHOLD = 8;
+
+// How far ahead of an input's head merge_k prefetches, in bytes (0 = off).
+// With many inputs each head is touched once every ~K outputs, too rarely
+// for the hardware prefetchers to follow 4096 streams.
+const size_t MERGE_K_PREFETCH_BYTES = 128;
+
+// parallel_merge_k gives each thread at least this many output elements
+const size_t MERGE_K_MIN_PARALLEL_SIZE = 1 << 16;
+
+namespace segment_sort {
+
+    // Read-only view of one sorted input
+    template<typename T>
+    struct SortedSpan {
+        const T* data = nullptr;
+        size_t size = 0;
+
+        SortedSpan() = default;
+        SortedSpan(const T* data, size_t size) : data(data), size(size) {}
+        SortedSpan(const std::vector<T>& v) : data(v.data()), size(v.size()) {}
+
+        const T* begin() const { return data; }
+        const T* end() const { return data + size; }
+    };
+
+    /**
+     * Helper: Number of elements at the front of [first, last) that precede
+     * value, found by exponential then binary search (cheap when the answer
+     * is small). With inclusive, elements equal to value also count
+     * (upper_bound); otherwise only smaller ones (lower_bound).
+     */
+    template<typename T, typename Compare>
+    size_t gallop_count(const T* first, const T* last, const T& value, bool inclusive, Compare comp) {
+        const size_t n = last - first;
+        auto precedes = [&](const T& x) { return inclusive ? !comp(value, x) : comp(x, value); };
+
+        size_t lo = 0;
+        size_t step = 1;
+        while (lo + step <= n && precedes(first[lo + step - 1])) {
+            lo += step;
+            step <<= 1;
+        }
+        size_t hi = std::min(n, lo + step - 1);
+        // Answer in [lo, hi]: first[lo..hi) remain to be checked
+        const T* pos = inclusive ? std::upper_bound(first + lo, first + hi, value, comp)
+                                 : std::lower_bound(first + lo, first + hi, value, comp);
+        return pos - first;
+    }
+
+    /**
+     * Loser tree over K inputs. Leaves are padded to a power of two; padded
+     * and exhausted inputs behave as +infinity. Each internal node keeps a
+     * copy of its loser's head key, so a replay walks one contiguous array
+     * instead of following node -> cursor -> head per level. The match at
+     * each level is computed without branches (on random input it is a coin
+     * flip): exhausted and padded nodes hold a real key (the first element
+     * of the first non-empty input) so comparing them is always safe, and
+     * a flag bit in their tag decides. Integral keys are selected with
+     * masks, since compilers turn a select of a struct back into branches.
+     * nodes_[0] holds the winner. Ties go to the lower input index, which
+     * makes the merge stable.
+     */
+    template<typename T, typename Compare>
+    class LoserTree {
+    public:
+        // Needs at least one non-empty input
+        LoserTree(const SortedSpan<T>* inputs, size_t k, Compare comp)
+            : comp_(comp), placeholder_(first_element(inputs)) {
+            leaves_ = 1;
+            while (leaves_ < k) leaves_ <<= 1;
+            cur_.assign(leaves_, nullptr);
+            end_.assign(leaves_, nullptr);
+            for (size_t i = 0; i < k; ++i) {
+                cur_[i] = inputs[i].data;
+                end_[i] = inputs[i].data + inputs[i].size;
+            }
+
+            // Bottom-up tournament: winners move up, losers stay in the node
+            nodes_.resize(leaves_, leaf(0));
+            std::vector<Node> winner(2 * leaves_);
+            for (size_t i = 0; i < leaves_; ++i) winner[leaves_ + i] = leaf(static_cast<uint32_t>(i));
+            for (size_t node = leaves_ - 1; node > 0; --node) {
+                Node a = winner[2 * node];
+                Node b = winner[2 * node + 1];
+                if (beats(b, a)) std::swap(a, b);
+                winner[node] = a;
+                nodes_[node] = b;
+            }
+            nodes_[0] = winner[1];
+        }
+
+        uint32_t winner() const { return nodes_[0].tag; }
+
+        // Best input other than the winner (the best loser on its path), or
+        // the winner itself when every other input is exhausted
+        uint32_t runner_up() const {
+            const uint32_t w = nodes_[0].tag;
+            Node best = nodes_[(w + leaves_) / 2];
+            for (size_t node = (w + leaves_) / 4; node > 0; node /= 2) {
+                if (beats(nodes_[node], best)) best = nodes_[node];
+            }
+            return (best.tag & EXHAUSTED) ? w : best.tag;
+        }
+
+        // Emit count elements of the winner and replay its path to the root
+        T* pop(T* out, size_t count) {
+            const uint32_t w = nodes_[0].tag;
+            if (count == 1) {
+                *out++ = *cur_[w];
+            } else {
+                out = std::copy(cur_[w], cur_[w] + count, out);
+            }
+            cur_[w] += count;
+            if (MERGE_K_PREFETCH_BYTES > 0 && cur_[w] + MERGE_K_PREFETCH_BYTES / sizeof(T) < end_[w]) {
+                SEGMENT_SORT_PREFETCH(cur_[w] + MERGE_K_PREFETCH_BYTES / sizeof(T));
+            }
+            Node current = leaf(w);
+            for (size_t node = (w + leaves_) / 2; node > 0; node /= 2) {
+                const Node loser = nodes_[node];
+                const bool swap = beats(loser, current);
+                nodes_[node] = select(swap, current, loser);
+                current = select(swap, loser, current);
+            }
+            nodes_[0] = current;
+            return out;
+        }
+
+        const T* head(uint32_t i) const { return cur_[i]; }
+        const T* tail(uint32_t i) const { return end_[i]; }
+
+    private:
+        // Input index, with the top bit set once the input is exhausted
+        static constexpr uint32_t EXHAUSTED = 1u << 31;
+
+        struct Node {
+            T key;
+            uint32_t tag;
+        };
+
+        Node leaf(uint32_t i) const {
+            if (cur_[i] != end_[i]) return Node{*cur_[i], i};
+            return Node{placeholder_, i | EXHAUSTED};
+        }
+
+        static Node select(bool condition, const Node& a, const Node& b) {
+            const uint32_t tag_mask = 0u - static_cast<uint32_t>(condition);
+            const uint32_t tag = (a.tag & tag_mask) | (b.tag & ~tag_mask);
+            // make_unsigned is ill-formed for bool
+            if constexpr (std::is_integral<T>::value && !std::is_same<T, bool>::value) {
+                using U = typename std::make_unsigned<T>::type;
+                const U key_mask = U(0) - static_cast<U>(condition);
+                const U key = (static_cast<U>(a.key) & key_mask) | (static_cast<U>(b.key) & ~key_mask);
+                return Node{static_cast<T>(key), tag};
+            } else {
+                return Node{condition ? a.key : b.key, tag};
+            }
+        }
+
+        static const T& first_element(const SortedSpan<T>* inputs) {
+            while (inputs->size == 0) ++inputs;
+            return inputs->data[0];
+        }
+
+        // True when node a comes before node b in the output
+        bool beats(const Node& a, const Node& b) const {
+            const uint32_t less = comp_(a.key, b.key);
+            const uint32_t greater = comp_(b.key, a.key);
+            const uint32_t ordered = less | ((greater ^ 1) & (a.tag < b.tag));
+            return ((a.tag >> 31) ^ 1) & ((b.tag >> 31) | ordered);
+        }
+
+        Compare comp_;
+        T placeholder_;
+        size_t leaves_;
+        std::vector<const T*> cur_;
+        std::vector<const T*> end_;
+        std::vector<Node> nodes_;
+    };
+
+    // Core: Sequential K-way merge of inputs[0..k) into out
+    template<size_t GallopThreshold, typename T, typename Compare>
+    size_t merge_k_impl(const SortedSpan<T>* inputs, size_t k, T* out, Compare comp) {
+        size_t total = 0;
+        for (size_t i = 0; i < k; ++i) total += inputs[i].size;
+        if (k == 0 || total == 0) return 0;
+        if (k == 1) {
+            std::copy(inputs[0].begin(), inputs[0].end(), out);
+            return total;
+        }
+
+        LoserTree<T, Compare> tree(inputs, k, comp);
+        T* const out_end = out + total;
+        uint32_t last = tree.winner();
+        size_t streak = 0;
+        while (out < out_end) {
+            const uint32_t w = tree.winner();
+            streak = streak * (w == last) + 1; // no branch: w changes at random
+            last = w;
+            if (GallopThreshold == 0 || streak < GallopThreshold) {
+                out = tree.pop(out, 1);
+                continue;
+            }
+
+            // Bulk copy: everything of w that precedes the runner-up's head
+            // (ties included when w has the lower index). The winner's head
+            // always qualifies, so at least one element moves.
+            const uint32_t r = tree.runner_up();
+            size_t count;
+            if (r == w) {
+                count = tree.tail(w) - tree.head(w);
+            } else {
+                count = gallop_count(tree.head(w), tree.tail(w), *tree.head(r), w < r, comp);
+            }
+            out = tree.pop(out, count);
+            streak = 0;
+        }
+        return total;
+    }
+
+    /**
+     * Helper: Split points of output rank r across inputs[0..k). Writes
+     * split[i] such that the first r elements of the merged output are
+     * exactly inputs[i][0..split[i]) for every i.
+     *
+     * Each round takes the middle of every remaining range [lo_i, hi_i),
+     * uses their median weighted by range length as pivot, and counts how
+     * many elements of each range precede it. Depending on whether that
+     * total is below or above r, at least half of the candidates (by
+     * weight) lose half of their range, so O(log total) rounds suffice.
+     */
+    template<typename T, typename Compare>
+    void co_rank(const SortedSpan<T>* inputs, size_t k, size_t r, size_t* split, Compare comp) {
+        std::vector<size_t> lo(k, 0);
+        std::vector<size_t> hi(k);
+        for (size_t i = 0; i < k; ++i) hi[i] = inputs[i].size;
+
+        struct Candidate {
+            size_t input;
+            size_t pos;
+            size_t weight;
+        };
+        std::vector<Candidate> candidates;
+        candidates.reserve(k);
+        std::vector<size_t> count(k);
+
+        // Order of the merged output: value, then input index
+        auto before = [&](const Candidate& a, const Candidate& b) {
+            const T& x = inputs[a.input].data[a.pos];
+            const T& y = inputs[b.input].data[b.pos];
+            return a.input < b.input ? !comp(y, x) : comp(x, y);
+        };
+
+        while (true) {
+            candidates.clear();
+            size_t total_weight = 0;
+            for (size_t i = 0; i < k; ++i) {
+                if (lo[i] < hi[i]) {
+                    candidates.push_back({i, lo[i] + (hi[i] - lo[i]) / 2, hi[i] - lo[i]});
+                    total_weight += hi[i] - lo[i];
+                }
+            }
+            if (candidates.empty()) break;
+
+            // Weighted median of the candidate middles
+            std::sort(candidates.begin(), candidates.end(), before);
+            size_t acc = 0;
+            size_t m = 0;
+            while (acc + candidates[m].weight < (total_weight + 1) / 2) acc += candidates[m++].weight;
+            const size_t p_input = candidates[m].input;
+            const size_t p_pos = candidates[m].pos;
+            const T& pivot = inputs[p_input].data[p_pos];
+
+            // Elements of each range that precede the pivot in output order.
+            // Searching only inside [lo, hi) is enough: the clamped total is
+            // below r, above r or equal to r exactly when the true one is,
+            // and when it equals r the clamped counts are the split.
+            size_t rank = 0;
+            for (size_t i = 0; i < k; ++i) {
+                const T* first = inputs[i].data + lo[i];
+                const T* last = inputs[i].data + hi[i];
+                if (i == p_input) {
+                    count[i] = p_pos;
+                } else if (i < p_input) {
+                    count[i] = std::upper_bound(first, last, pivot, comp) - inputs[i].data;
+                } else {
+                    count[i] = std::lower_bound(first, last, pivot, comp) - inputs[i].data;
+                }
+                rank += count[i];
+            }
+
+            if (rank == r) {
+                lo = count;
+                break;
+            }
+            if (rank < r) {
+                // The pivot and everything before it are in the first r
+                for (size_t i = 0; i < k; ++i) lo[i] = count[i];
+                lo[p_input] = p_pos + 1;
+            } else {
+                for (size_t i = 0; i < k; ++i) hi[i] = count[i];
+            }
+        }
+        std::copy(lo.begin(), lo.end(), split);
+    }
+
+    /**
+     * Merges the sorted inputs[0..k) into out (which must have room for the
+     * sum of their sizes) and returns the number of elements written.
+     */
+    template<size_t GallopThreshold = MERGE_K_GALLOP_THRESHOLD,
+             typename T,
+             typename Compare = std::less<T>>
+    size_t merge_k(const SortedSpan<T>* inputs, size_t k, T* out, Compare comp = Compare()) {
+        return merge_k_impl<GallopThreshold>(inputs, k, out, comp);
+    }
+
+    template<size_t GallopThreshold = MERGE_K_GALLOP_THRESHOLD,
+             typename T,
+             typename Compare = std::less<T>>
+    size_t merge_k(const std::vector<SortedSpan<T>>& inputs, T* out, Compare comp = Compare()) {
+        return merge_k_impl<GallopThreshold>(inputs.data(), inputs.size(), out, comp);
+    }
+
+    /**
+     * Parallel merge_k with up to num_threads threads (0 = hardware
+     * concurrency). Fewer threads are used when a slice would be shorter
+     * than MERGE_K_MIN_PARALLEL_SIZE. The output is identical to merge_k.
+     */
+    template<size_t GallopThreshold = MERGE_K_GALLOP_THRESHOLD,
+             typename T,
+             typename Compare = std::less<T>>
+    size_t parallel_merge_k(const SortedSpan<T>* inputs, size_t k, T* out,
+                            size_t num_threads = 0, Compare comp = Compare()) {
+        size_t total = 0;
+        for (size_t i = 0; i < k; ++i) total += inputs[i].size;
+        if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+        num_threads = std::min(num_threads, std::max<size_t>(1, total / MERGE_K_MIN_PARALLEL_SIZE));
+        if (num_threads <= 1 || k <= 1) return merge_k_impl<GallopThreshold>(inputs, k, out, comp);
+
+        // Slice t covers output ranks [total * t / T, total * (t + 1) / T).
+        // Each thread co-ranks both of its boundaries, then merges its
+        // sub-spans straight into its part of out.
+        auto merge_slice = [&](size_t t) {
+            const size_t begin = total * t / num_threads;
+            const size_t end = total * (t + 1) / num_threads;
+            std::vector<size_t> from(k, 0);
+            std::vector<size_t> to(k);
+            if (t > 0) co_rank(inputs, k, begin, from.data(), comp);
+            if (t + 1 < num_threads) {
+                co_rank(inputs, k, end, to.data(), comp);
+            } else {
+                for (size_t i = 0; i < k; ++i) to[i] = inputs[i].size;
+            }
+
+            std::vector<SortedSpan<T>> parts(k);
+            for (size_t i = 0; i < k; ++i) parts[i] = SortedSpan<T>(inputs[i].data + from[i], to[i] - from[i]);
+            merge_k_impl<GallopThreshold>(parts.data(), k, out + begin, comp);
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(num_threads - 1);
+        for (size_t t = 1; t < num_threads; ++t) workers.emplace_back(merge_slice, t);
+        merge_slice(0);
+        for (auto& worker : workers) worker.join();
+        return total;
+    }
+
+    template<size_t GallopThreshold = MERGE_K_GALLOP_THRESHOLD,
+             typename T,
+             typename Compare = std::less<T>>
+    size_t parallel_merge_k(const std::vector<SortedSpan<T>>& inputs, T* out,
+                            size_t num_threads = 0, Compare comp = Compare()) {
+        return parallel_merge_k<GallopThreshold>(inputs.data(), inputs.size(), out, num_threads, comp);
+    }
+
+#if __cplusplus >= 202002L
+    // Helper: std::span inputs as SortedSpans
+    template<typename T>
+    std::vector<SortedSpan<T>> to_sorted_spans(std::span<const std::span<const T>> inputs) {
+        std::vector<SortedSpan<T>> spans;
+        spans.reserve(inputs.size());
+        for (const auto& input : inputs) spans.emplace_back(input.data(), input.size());
+        return spans;
+    }
+
+    template<size_t GallopThreshold = MERGE_K_GALLOP_THRESHOLD,
+             typename T,
+             typename Compare = std::less<T>>
+    size_t merge_k(std::span<const std::span<const T>> inputs, T* out, Compare comp = Compare()) {
+        return merge_k<GallopThreshold>(to_sorted_spans(inputs), out, comp);
+    }
+
+    template<size_t GallopThreshold = MERGE_K_GALLOP_THRESHOLD,
+             typename T,
+             typename Compare = std::less<T>>
+    size_t parallel_merge_k(std::span<const std::span<const T>> inputs, T* out,
+                            size_t num_threads = 0, Compare comp = Compare()) {
+        return parallel_merge_k<GallopThreshold>(to_sorted_spans(inputs), out, num_threads, comp);
+    }
+#endif
+}
+
+#endif // MERGE_K_HPP
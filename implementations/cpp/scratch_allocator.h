@@ -0,0 +1,168 @@
+/**
+ * Scratch Memory Policies - C++ Implementation
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Allocator for the merge buffer of block_merge_segment_sort. For 100M+
+ * element sorts the buffer spans hundreds of MB, and TLB misses and remote
+ * NUMA traffic show up in the merge loops. Policies (flags, combinable):
+ * - SCRATCH_DEFAULT      operator new, same as std::allocator
+ * - SCRATCH_HUGE_PAGES   2MB-aligned anonymous mmap: MAP_HUGETLB when the
+ *                        system has huge pages reserved, otherwise
+ *                        madvise(MADV_HUGEPAGE) for transparent huge pages
+ * - SCRATCH_NUMA_LOCAL   mbind(MPOL_PREFERRED) to the NUMA node of the
+ *                        calling thread before first touch (raw syscalls,
+ *                        no libnuma). Each thread sorting with its own buffer
+ *                        gets memory on its own node.
+ * Requests below SCRATCH_MAP_THRESHOLD bytes, and every request outside
+ * Linux, go to operator new: they live in cache, so page size and node
+ * placement do not matter.
+ */
+
+#ifndef SEGMENT_SORT_SCRATCH_ALLOCATOR_HPP
+#define SEGMENT_SORT_SCRATCH_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace segment_sort {
+
+    enum ScratchPolicy : unsigned {
+        SCRATCH_DEFAULT = 0,
+        SCRATCH_HUGE_PAGES = 1,
+        SCRATCH_NUMA_LOCAL = 2,
+    };
+
+    // Combines policy flags: SCRATCH_HUGE_PAGES | SCRATCH_NUMA_LOCAL
+    constexpr ScratchPolicy operator|(ScratchPolicy a, ScratchPolicy b) {
+        return static_cast<ScratchPolicy>(static_cast<unsigned>(a) | static_cast<unsigned>(b));
+    }
+
+    // Huge page size on x86-64 and aarch64 with 4K base pages
+    const size_t SCRATCH_HUGE_PAGE_SIZE = size_t(2) << 20;
+    // Smaller requests ignore the policy
+    const size_t SCRATCH_MAP_THRESHOLD = SCRATCH_HUGE_PAGE_SIZE;
+
+    namespace detail {
+
+#if defined(__linux__)
+        // NUMA node of the calling thread, -1 if unknown
+        inline int current_numa_node() {
+#ifdef SYS_getcpu
+            unsigned cpu = 0, node = 0;
+            if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) return static_cast<int>(node);
+#endif
+            return -1;
+        }
+
+        // Prefer the local node for [addr, addr + bytes); must run before first touch
+        inline void bind_to_local_node(void* addr, size_t bytes) {
+#ifdef SYS_mbind
+            const int MPOL_PREFERRED_MODE = 1;
+            int node = current_numa_node();
+            if (node < 0 || node >= static_cast<int>(8 * sizeof(unsigned long))) return;
+            unsigned long mask = 1UL << node;
+            // The kernel reads maxnode - 1 bits, so + 1 to cover node 63 (as libnuma does)
+            syscall(SYS_mbind, addr, bytes, MPOL_PREFERRED_MODE, &mask, 8 * sizeof(mask) + 1, 0);
+#else
+            (void)addr; (void)bytes;
+#endif
+        }
+
+        // bytes is a multiple of SCRATCH_HUGE_PAGE_SIZE; nullptr on failure
+        inline void* scratch_map(size_t bytes, ScratchPolicy policy) {
+            void* p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+            if (policy & SCRATCH_HUGE_PAGES) {
+                p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            }
+#endif
+            if (p == MAP_FAILED) {
+                // Over-map by one huge page and trim, so THP can back every 2MB
+                size_t padded = bytes + SCRATCH_HUGE_PAGE_SIZE;
+                void* raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (raw == MAP_FAILED) return nullptr;
+                uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+                uintptr_t aligned = (start + SCRATCH_HUGE_PAGE_SIZE - 1) & ~(uintptr_t(SCRATCH_HUGE_PAGE_SIZE) - 1);
+                if (aligned > start) munmap(raw, aligned - start);
+                size_t tail = (start + padded) - (aligned + bytes);
+                if (tail > 0) munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+                p = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+                if (policy & SCRATCH_HUGE_PAGES) madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+            }
+            if (policy & SCRATCH_NUMA_LOCAL) bind_to_local_node(p, bytes);
+            return p;
+        }
+#endif
+
+        inline size_t round_to_huge_page(size_t bytes) {
+            return (bytes + SCRATCH_HUGE_PAGE_SIZE - 1) & ~(SCRATCH_HUGE_PAGE_SIZE - 1);
+        }
+
+    } // namespace detail
+
+    /**
+     * Stateful allocator carrying a ScratchPolicy. With SCRATCH_DEFAULT it
+     * behaves like std::allocator. Whether a block was mapped only depends
+     * on (policy, size), so deallocate takes the same path as allocate.
+     */
+    template<typename T>
+    class ScratchAllocator {
+    public:
+        using value_type = T;
+
+        ScratchAllocator(ScratchPolicy policy = SCRATCH_DEFAULT) noexcept : policy_(policy) {}
+
+        template<typename U>
+        ScratchAllocator(const ScratchAllocator<U>& other) noexcept : policy_(other.policy()) {}
+
+        ScratchPolicy policy() const noexcept { return policy_; }
+
+        T* allocate(size_t n) {
+            size_t bytes = n * sizeof(T);
+#if defined(__linux__)
+            if (mapped(bytes)) {
+                void* p = detail::scratch_map(detail::round_to_huge_page(bytes), policy_);
+                if (!p) throw std::bad_alloc();
+                return static_cast<T*>(p);
+            }
+#endif
+            return static_cast<T*>(::operator new(bytes));
+        }
+
+        void deallocate(T* p, size_t n) noexcept {
+            size_t bytes = n * sizeof(T);
+#if defined(__linux__)
+            if (mapped(bytes)) {
+                munmap(p, detail::round_to_huge_page(bytes));
+                return;
+            }
+#endif
+            ::operator delete(p);
+        }
+
+        template<typename U>
+        bool operator==(const ScratchAllocator<U>& other) const noexcept { return policy_ == other.policy(); }
+        template<typename U>
+        bool operator!=(const ScratchAllocator<U>& other) const noexcept { return policy_ != other.policy(); }
+
+    private:
+        ScratchPolicy policy_;
+
+        bool mapped(size_t bytes) const noexcept {
+            return policy_ != SCRATCH_DEFAULT && bytes >= SCRATCH_MAP_THRESHOLD;
+        }
+    };
+
+} // namespace segment_sort
+
+#endif // SEGMENT_SORT_SCRATCH_ALLOCATOR_HPP
@@ -1,17 +1,26 @@
 #include <iostream>
 #include <vector>
 #include <queue>
+#include <functional>
+#include <utility>
 using namespace std;
 
+// Segment Sort original: detecta segmentos y los fusiona con un min-heap.
+// Estable: los segmentos son no-descendentes o estrictamente descendentes
+// (recorrer uno descendente hacia atrás no invierte iguales) y los empates
+// entre segmentos se resuelven por orden de aparición en la entrada.
+template <typename T = int, typename Compare = less<T>>
 class SegmentSort
 {
 private:
-    vector<int> copyarr;
+    vector<T> copyarr;
+    Compare comp;
 
     struct Segment
     {
-        int start;
-        int length;
+        long long start;
+        long long length; // > 0 ascendente, < 0 descendente (se recorre hacia atrás)
+        size_t id;        // Orden del segmento en la entrada (desempate estable)
     };
 
     struct CompareSegments
@@ -22,52 +31,44 @@ private:
 
         bool operator()(const Segment &a, const Segment &b)
         {
-            return segmentSort->copyarr[a.start] > segmentSort->copyarr[b.start]; // Min-heap based on the start index
+            const T &va = segmentSort->copyarr[a.start];
+            const T &vb = segmentSort->copyarr[b.start];
+            if (segmentSort->comp(vb, va))
+                return true; // Min-heap based on the head value
+            if (segmentSort->comp(va, vb))
+                return false;
+            return a.id > b.id;
         }
     };
 
 public:
-    void sort(vector<int> &arr)
+    SegmentSort(Compare c = Compare()) : comp(c) {}
+
+    void sort(vector<T> &arr)
     {
-        int n = arr.size();
+        long long n = arr.size();
         copyarr = arr;
 
         // Identify segments
         vector<Segment> segments;
-        int start = 0;
-        int direction = 0; // 0 unknown, > 0 increasing, < 0 decreasing
+        long long start = 0;
 
-        for (int i = 1; i < n; ++i)
+        while (start < n)
         {
-            if (direction == 0)
-            {
-                direction = arr[i] - arr[i - 1];
-                continue;
-            }
-            if ((direction > 0) && arr[i - 1] > arr[i])
-            { // Found a decreasing segment
-                int length = i - start;
-                segments.push_back({start, length});
-                start = i;
-                direction = 0;
+            long long end = start + 1;
+            if (end < n && comp(arr[end], arr[start]))
+            { // Strictly decreasing segment
+                while (end < n && comp(arr[end], arr[end - 1]))
+                    end++;
+                segments.push_back({end - 1, start - end, segments.size()});
             }
-            else if ((direction < 0) && arr[i - 1] < arr[i])
-            { // Found a increasing segment
-                int length = start - i;
-                segments.push_back({i - 1, length});
-                start = i;
-                direction = 0;
+            else
+            { // Non-decreasing segment
+                while (end < n && !comp(arr[end], arr[end - 1]))
+                    end++;
+                segments.push_back({start, end - start, segments.size()});
             }
-        }
-        if (direction >= 0)
-        {
-            int length = n - start;
-            segments.push_back({start, length});
-        }
-        else
-        {
-            int length = start - n;
-            segments.push_back({n - 1, length});
+            start = end;
         }
 
         // for (auto x : segments) { cout << x.start << " - " << x.length << "\n"; }
@@ -75,14 +76,13 @@ public:
         // Use a min-heap to extract the minimum element from the heads of each segment
         CompareSegments compareSegments(this); // Pasa la instancia de la clase
         priority_queue<Segment, vector<Segment>, CompareSegments> minHeap(compareSegments);
-        ;
         for (const auto &segment : segments)
         {
             minHeap.push(segment);
         }
 
         // Reconstruct the array
-        for (int i = 0; i < n; ++i)
+        for (long long i = 0; i < n; ++i)
         {
             Segment current = minHeap.top();
             minHeap.pop();
@@ -131,5 +131,21 @@ int main()
         cout << x << " ";
     }
     cout << "\n";
-    return 0;
+
+    // Estabilidad: registros (clave, orden original) ordenados solo por clave
+    vector<pair<int, int>> records = {{3, 0}, {1, 1}, {3, 2}, {2, 3}, {2, 4}, {1, 5}, {3, 6}, {1, 7}};
+    auto byKey = [](const pair<int, int> &a, const pair<int, int> &b) { return a.first < b.first; };
+    SegmentSort<pair<int, int>, decltype(byKey)> recordSort(byKey);
+    recordSort.sort(records);
+
+    cout << "Registros ordenados (clave:orden): ";
+    bool stable = true;
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        cout << records[i].first << ":" << records[i].second << " ";
+        if (i > 0 && records[i - 1].first == records[i].first && records[i - 1].second > records[i].second)
+            stable = false;
+    }
+    cout << "\n" << (stable ? "Estable" : "INESTABLE") << "\n";
+    return stable ? 0 : 1;
 }
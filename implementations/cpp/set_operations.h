@@ -0,0 +1,386 @@
+/**
+ * Sorted Set Operations - C++ Implementation
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Union, intersection, difference and merge_unique of two sorted inputs
+ * (the output of block_merge_segment_sort, merge_k, or any SortedSpan):
+ *
+ * - The same result as std::set_union / std::set_intersection /
+ *   std::set_difference, multiset semantics included, plus merge_unique,
+ *   which keeps one copy of every distinct value of both inputs.
+ * - When one input advances SET_OPS_GALLOP_THRESHOLD times in a row, the
+ *   rest of its stretch below the other input's head is found by
+ *   exponential search and copied (or skipped) in bulk, so long
+ *   non-overlapping stretches cost O(log length) comparisons.
+ * - With AVX2, set_intersection of 32-bit and 64-bit integers compares a
+ *   block of one input against every element of a block of the other with
+ *   rotated vector compares (8 x 8 or 4 x 4 pairs per step) and advances
+ *   the block with the smaller last element.
+ *
+ * Equal elements are taken from the first input, like the std algorithms.
+ */
+
+#ifndef SET_OPERATIONS_HPP
+#define SET_OPERATIONS_HPP
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#include "merge_k.h"
+
+#if defined(__AVX2__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define SEGMENT_SORT_SIMD_INTERSECTION 1
+#else
+#define SEGMENT_SORT_SIMD_INTERSECTION 0
+#endif
+
+// Consecutive steps of one input before the set operations gallop (0 = off)
+const size_t SET_OPS_GALLOP_THRESHOLD = 8;
+
+// Steps per window of the adaptive branchless / branching walk
+const size_t SET_OPS_WINDOW = 64;
+
+// The SIMD intersection is used while the inputs differ in size by at most
+// this factor; beyond it galloping from the smaller input is cheaper
+const size_t SET_OPS_SIMD_MAX_RATIO = 32;
+
+namespace segment_sort {
+
+    enum class SetOperation {
+        Union,
+        Intersection,
+        Difference,
+        MergeUnique
+    };
+
+    // True when the SIMD intersection applies: 32/64-bit integers in an
+    // order where equal means identical (std::less / std::greater)
+    template<typename T, typename Compare>
+    struct simd_intersectable : std::integral_constant<bool,
+        SEGMENT_SORT_SIMD_INTERSECTION &&
+        network_sortable<T, Compare>::value && (sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+#if SEGMENT_SORT_SIMD_INTERSECTION
+    // Helper: Bit k set when a[k] equals any of b[0..lanes)
+    template<typename T>
+    inline unsigned simd_match_mask(const T* a, const T* b) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+        if constexpr (sizeof(T) == 4) {
+            const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+            __m256i match = _mm256_cmpeq_epi32(va, vb);
+            for (int r = 1; r < 8; ++r) {
+                vb = _mm256_permutevar8x32_epi32(vb, rotate);
+                match = _mm256_or_si256(match, _mm256_cmpeq_epi32(va, vb));
+            }
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(match)));
+        } else {
+            __m256i match = _mm256_cmpeq_epi64(va, vb);
+            for (int r = 1; r < 4; ++r) {
+                vb = _mm256_permute4x64_epi64(vb, 0x39);
+                match = _mm256_or_si256(match, _mm256_cmpeq_epi64(va, vb));
+            }
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(match)));
+        }
+    }
+
+    // Helper: Bit k set when a[k] == a[k + 1], for k in [0, lanes)
+    template<typename T>
+    inline unsigned simd_adjacent_equal_mask(const T* a) {
+        const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+        const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + 1));
+        if constexpr (sizeof(T) == 4) {
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v0, v1))));
+        } else {
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v0, v1))));
+        }
+    }
+
+    /**
+     * Core: Block-wise intersection. Advances i and j (and out) while both
+     * inputs have more than one block left; the caller finishes the tails.
+     *
+     * A block pair without matches is skipped by advancing the block with
+     * the smaller last element (nothing in it can match later elements of
+     * the other input). Matches are written straight from the mask when
+     * both blocks, including the element after each, hold no equal
+     * neighbours: then every value matches at most once, as in
+     * std::set_intersection. Otherwise this block pair is merged one
+     * element at a time (branchless), which gets duplicates right. When
+     * that happens for more than a quarter of 64 matching block pairs, the
+     * inputs are multisets rather than sets and the scalar walk of the
+     * caller takes over.
+     */
+    template<typename T, typename Compare>
+    void simd_intersection(const T*& i, const T* a_end, const T*& j, const T* b_end, T*& out, Compare comp) {
+        constexpr size_t lanes = 32 / sizeof(T);
+        size_t streak_a = 0;
+        size_t streak_b = 0;
+        size_t matched_blocks = 0;
+        size_t duplicate_blocks = 0;
+        while (static_cast<size_t>(a_end - i) > lanes && static_cast<size_t>(b_end - j) > lanes) {
+            unsigned mask = simd_match_mask(i, j);
+            const T& a_last = i[lanes - 1];
+            const T& b_last = j[lanes - 1];
+
+            if (mask == 0) {
+                // Long stretches of one input below the other: gallop
+                if (comp(a_last, b_last)) {
+                    i += lanes;
+                    streak_b = 0;
+                    if (SET_OPS_GALLOP_THRESHOLD > 0 && ++streak_a >= SET_OPS_GALLOP_THRESHOLD) {
+                        i += gallop_count(i, a_end, *j, false, comp);
+                        streak_a = 0;
+                    }
+                } else {
+                    j += lanes;
+                    streak_a = 0;
+                    if (SET_OPS_GALLOP_THRESHOLD > 0 && ++streak_b >= SET_OPS_GALLOP_THRESHOLD) {
+                        j += gallop_count(j, b_end, *i, false, comp);
+                        streak_b = 0;
+                    }
+                }
+                continue;
+            }
+            streak_a = 0;
+            streak_b = 0;
+            if (++matched_blocks == 64) {
+                if (duplicate_blocks * 4 > matched_blocks) return;
+                matched_blocks = 0;
+                duplicate_blocks = 0;
+            }
+
+            if (simd_adjacent_equal_mask(i) | simd_adjacent_equal_mask(j)) {
+                ++duplicate_blocks;
+                const T* i_stop = i + lanes;
+                const T* j_stop = j + lanes;
+                while (i < i_stop && j < j_stop) {
+                    const bool less = comp(*i, *j);
+                    const bool greater = comp(*j, *i);
+                    *out = *i;
+                    out += !less & !greater;
+                    i += !greater;
+                    j += !less;
+                }
+                continue;
+            }
+
+            // Store every lane, keep the matched ones. Stays inside out:
+            // each output consumed an element of both inputs, and both
+            // still have more than one block left.
+            for (size_t k = 0; k < lanes; ++k) {
+                *out = i[k];
+                out += (mask >> k) & 1;
+            }
+            const bool advance_a = !comp(b_last, a_last);
+            const bool advance_b = !comp(a_last, b_last);
+            i += advance_a ? lanes : 0;
+            j += advance_b ? lanes : 0;
+        }
+    }
+#endif
+
+    /**
+     * Core: Two-cursor walk shared by the four operations. Op decides what
+     * is emitted for elements only in a, only in b, and equal pairs. After
+     * SET_OPS_GALLOP_THRESHOLD consecutive steps on one side, the rest of
+     * that side's stretch below the other head is emitted (or skipped) in
+     * one go.
+     *
+     * For small trivially copyable T a step can run without branches: the
+     * candidate is always stored and the output and cursors advance by the
+     * compare results. The store never passes the capacity: an output slot
+     * is only reused while an element that would fill it remains. That wins
+     * on interleaved inputs, where the std algorithms mispredict about
+     * every other step, and loses on regular ones (identical inputs, runs
+     * of duplicates), where their branches predict. The walk goes in
+     * windows of SET_OPS_WINDOW steps and takes the branchless loop after a
+     * window whose outcome changed on more than a quarter of its steps.
+     */
+    template<SetOperation Op, typename T, typename Compare>
+    size_t set_operation(SortedSpan<T> a, SortedSpan<T> b, T* out, Compare comp) {
+        constexpr bool emit_a_only = Op != SetOperation::Intersection;
+        constexpr bool emit_b_only = Op == SetOperation::Union || Op == SetOperation::MergeUnique;
+        constexpr bool emit_equal = Op != SetOperation::Difference;
+
+        T* const out_begin = out;
+        // merge_unique drops an element that does not exceed the last output
+        auto emit = [&](const T& value) {
+            if (Op != SetOperation::MergeUnique || out == out_begin || comp(out[-1], value)) *out++ = value;
+        };
+        auto emit_range = [&](const T* first, const T* last) {
+            if (Op == SetOperation::MergeUnique) {
+                for (; first != last; ++first) emit(*first);
+            } else {
+                out = std::copy(first, last, out);
+            }
+        };
+
+        const T* i = a.begin();
+        const T* j = b.begin();
+        const T* const a_end = a.end();
+        const T* const b_end = b.end();
+
+#if SEGMENT_SORT_SIMD_INTERSECTION
+        if constexpr (Op == SetOperation::Intersection && simd_intersectable<T, Compare>::value) {
+            if (a.size <= b.size * SET_OPS_SIMD_MAX_RATIO && b.size <= a.size * SET_OPS_SIMD_MAX_RATIO) {
+                simd_intersection(i, a_end, j, b_end, out, comp);
+            }
+        }
+#endif
+
+        size_t streak_a = 0;
+        size_t streak_b = 0;
+        // Emits (or skips) a's stretch below *j / b's stretch below *i
+        auto gallop = [&]() {
+            if (SET_OPS_GALLOP_THRESHOLD == 0) return;
+            if (streak_a >= SET_OPS_GALLOP_THRESHOLD) {
+                const T* stop = i + gallop_count(i, a_end, *j, false, comp);
+                if (emit_a_only) emit_range(i, stop);
+                i = stop;
+                streak_a = 0;
+            } else if (streak_b >= SET_OPS_GALLOP_THRESHOLD) {
+                const T* stop = j + gallop_count(j, b_end, *i, false, comp);
+                if (emit_b_only) emit_range(j, stop);
+                j = stop;
+                streak_b = 0;
+            }
+        };
+
+        constexpr bool can_branchless = std::is_trivially_copyable<T>::value && sizeof(T) <= 16;
+        bool branchless = can_branchless;
+        while (i != a_end && j != b_end) {
+            // One window; the next one picks its loop from how often the
+            // step outcome (a first, b first, equal) changed in this one
+            size_t changes = 0;
+            if (can_branchless && branchless) {
+                unsigned previous = 0;
+                for (size_t step = 0; step < SET_OPS_WINDOW && i != a_end && j != b_end; ++step) {
+                    const bool less = comp(*i, *j);
+                    const bool greater = comp(*j, *i);
+                    if (Op == SetOperation::Union) {
+                        *out++ = greater ? *j : *i;
+                    } else if (Op == SetOperation::MergeUnique) {
+                        const T value = greater ? *j : *i;
+                        *out = value;
+                        out += out == out_begin || comp(out[-1], value);
+                    } else if (Op == SetOperation::Intersection) {
+                        *out = *i;
+                        out += !less & !greater;
+                    } else {
+                        *out = *i;
+                        out += less;
+                    }
+                    i += !greater;
+                    j += !less;
+
+                    const unsigned outcome = less + 2 * greater;
+                    changes += outcome != previous;
+                    previous = outcome;
+                    streak_a = (streak_a + 1) & (size_t(0) - less);
+                    streak_b = (streak_b + 1) & (size_t(0) - greater);
+                    gallop();
+                }
+            } else {
+                unsigned previous = 0;
+                for (size_t step = 0; step < SET_OPS_WINDOW && i != a_end && j != b_end; ++step) {
+                    unsigned outcome;
+                    if (comp(*i, *j)) {
+                        if (emit_a_only) emit(*i);
+                        ++i;
+                        ++streak_a;
+                        streak_b = 0;
+                        outcome = 1;
+                    } else if (comp(*j, *i)) {
+                        if (emit_b_only) emit(*j);
+                        ++j;
+                        ++streak_b;
+                        streak_a = 0;
+                        outcome = 2;
+                    } else {
+                        if (emit_equal) emit(*i);
+                        ++i;
+                        ++j;
+                        streak_a = 0;
+                        streak_b = 0;
+                        outcome = 0;
+                    }
+                    changes += outcome != previous;
+                    previous = outcome;
+                    gallop();
+                }
+            }
+            branchless = changes * 4 > SET_OPS_WINDOW;
+        }
+
+        if (emit_a_only) emit_range(i, a_end);
+        if (emit_b_only) emit_range(j, b_end);
+        return out - out_begin;
+    }
+
+    /**
+     * Sorted union of a and b into out (room for a.size + b.size). An
+     * element present m times in a and n times in b appears max(m, n)
+     * times. Returns the number of elements written.
+     */
+    template<typename T, typename Compare = std::less<T>>
+    size_t set_union(SortedSpan<T> a, SortedSpan<T> b, T* out, Compare comp = Compare()) {
+        return set_operation<SetOperation::Union>(a, b, out, comp);
+    }
+
+    // Sorted intersection (min(m, n) copies) into out (room for min(a.size, b.size))
+    template<typename T, typename Compare = std::less<T>>
+    size_t set_intersection(SortedSpan<T> a, SortedSpan<T> b, T* out, Compare comp = Compare()) {
+        return set_operation<SetOperation::Intersection>(a, b, out, comp);
+    }
+
+    // Elements of a not matched in b (max(m - n, 0) copies) into out (room for a.size)
+    template<typename T, typename Compare = std::less<T>>
+    size_t set_difference(SortedSpan<T> a, SortedSpan<T> b, T* out, Compare comp = Compare()) {
+        return set_operation<SetOperation::Difference>(a, b, out, comp);
+    }
+
+    // Every distinct value of a and b once, into out (room for a.size + b.size)
+    template<typename T, typename Compare = std::less<T>>
+    size_t merge_unique(SortedSpan<T> a, SortedSpan<T> b, T* out, Compare comp = Compare()) {
+        return set_operation<SetOperation::MergeUnique>(a, b, out, comp);
+    }
+
+    // Vector versions returning the result
+    template<SetOperation Op, typename T, typename Compare>
+    std::vector<T> set_operation(const std::vector<T>& a, const std::vector<T>& b, Compare comp) {
+        size_t capacity = a.size() + b.size();
+        if (Op == SetOperation::Intersection) capacity = std::min(a.size(), b.size());
+        if (Op == SetOperation::Difference) capacity = a.size();
+        std::vector<T> out(capacity);
+        out.resize(set_operation<Op>(SortedSpan<T>(a), SortedSpan<T>(b), out.data(), comp));
+        return out;
+    }
+
+    template<typename T, typename Compare = std::less<T>>
+    std::vector<T> set_union(const std::vector<T>& a, const std::vector<T>& b, Compare comp = Compare()) {
+        return set_operation<SetOperation::Union>(a, b, comp);
+    }
+
+    template<typename T, typename Compare = std::less<T>>
+    std::vector<T> set_intersection(const std::vector<T>& a, const std::vector<T>& b, Compare comp = Compare()) {
+        return set_operation<SetOperation::Intersection>(a, b, comp);
+    }
+
+    template<typename T, typename Compare = std::less<T>>
+    std::vector<T> set_difference(const std::vector<T>& a, const std::vector<T>& b, Compare comp = Compare()) {
+        return set_operation<SetOperation::Difference>(a, b, comp);
+    }
+
+    template<typename T, typename Compare = std::less<T>>
+    std::vector<T> merge_unique(const std::vector<T>& a, const std::vector<T>& b, Compare comp = Compare()) {
+        return set_operation<SetOperation::MergeUnique>(a, b, comp);
+    }
+}
+
+#endif // SET_OPERATIONS_HPP
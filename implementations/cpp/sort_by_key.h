@@ -0,0 +1,121 @@
+/**
+ * Key-Value Sort (Satellite Data) - C++ Implementation
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Sorts a key array with Block Merge Segment Sort and applies the resulting
+ * permutation to one or more parallel value arrays (SoA layout). Merges only
+ * move (key, index) pairs through the buffer; every value array is permuted
+ * exactly once at the end, so wide payloads are moved once instead of once
+ * per merge level.
+ */
+
+#ifndef SORT_BY_KEY_HPP
+#define SORT_BY_KEY_HPP
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "block_merge_segment_sort.h"
+
+namespace segment_sort {
+
+    // Key tagged with its original position. This is what flows through the
+    // run detection and the buffered merges instead of whole rows.
+    template<typename K, typename IndexT>
+    struct KeyIndex {
+        K key;
+        IndexT index;
+    };
+
+    // Helper: Permute one or more arrays in place so that position i receives
+    // the element previously at source_of(i). Each cycle is followed once and
+    // all arrays move together; mark_done(i) is called for every position
+    // placed so the caller can flag it (source_of(i) == i afterwards).
+    template<typename SourceOf, typename MarkDone, typename... V>
+    void apply_permutation(size_t n, SourceOf source_of, MarkDone mark_done, V*... values) {
+        for (size_t i = 0; i < n; ++i) {
+            if (source_of(i) == i) continue;
+
+            // Save position i, then pull each element of the cycle forward
+            auto saved = std::make_tuple(std::move(values[i])...);
+            size_t j = i;
+            while (true) {
+                size_t k = source_of(j);
+                mark_done(j);
+                if (k == i) {
+                    std::apply([&](auto&... held) { ((values[j] = std::move(held)), ...); }, saved);
+                    break;
+                }
+                ((values[j] = std::move(values[k])), ...);
+                j = k;
+            }
+        }
+    }
+
+    template<typename IndexT, typename K, typename... V>
+    void sort_by_key_impl(K* keys, size_t n, size_t buffer_size, V*... values) {
+        if (n <= 1) return;
+
+        // 1. Tag keys with their positions
+        std::vector<KeyIndex<K, IndexT>> items(n);
+        for (size_t i = 0; i < n; ++i) {
+            items[i].key = std::move(keys[i]);
+            items[i].index = static_cast<IndexT>(i);
+        }
+
+        // 2. Run detection + buffered merges over (key, index) only.
+        // Stable, so equal keys keep their original relative order.
+        block_merge_segment_sort(items.data(), n, buffer_size,
+            [](const KeyIndex<K, IndexT>& a, const KeyIndex<K, IndexT>& b) {
+                return a.key < b.key;
+            });
+
+        // 3. Write keys back and apply the permutation once to every value array
+        for (size_t i = 0; i < n; ++i) {
+            keys[i] = std::move(items[i].key);
+        }
+        if constexpr (sizeof...(V) > 0) {
+            apply_permutation(n,
+                [&items](size_t i) { return static_cast<size_t>(items[i].index); },
+                [&items](size_t i) { items[i].index = static_cast<IndexT>(i); },
+                values...);
+        }
+    }
+
+    /**
+     * @brief Sort keys and move parallel value arrays in lockstep.
+     *
+     * Equivalent to a stable sort of the rows (keys[i], values[i]...) by key,
+     * but the merge phase only touches keys and 32-bit (or 64-bit when
+     * n >= 2^32) indices. Memory: n * sizeof(KeyIndex) + merge buffer.
+     *
+     * @param keys Pointer to the key array (sorted in place).
+     * @param n Number of rows.
+     * @param values Pointers to the parallel value arrays (n elements each).
+     */
+    template<typename K, typename... V>
+    void sort_by_key(K* keys, size_t n, V*... values) {
+        if (n <= std::numeric_limits<uint32_t>::max()) {
+            sort_by_key_impl<uint32_t>(keys, n, BLOCK_MERGE_DEFAULT_BUFFER_SIZE, values...);
+        } else {
+            sort_by_key_impl<size_t>(keys, n, BLOCK_MERGE_DEFAULT_BUFFER_SIZE, values...);
+        }
+    }
+
+    // Vector overload. All value vectors must have the same size as keys.
+    template<typename K, typename... V>
+    void sort_by_key(std::vector<K>& keys, std::vector<V>&... values) {
+        size_t n = keys.size();
+        if (((values.size() != n) || ...)) {
+            throw std::invalid_argument("sort_by_key: value array size differs from key array size");
+        }
+        sort_by_key(keys.data(), n, values.data()...);
+    }
+}
+
+#endif // SORT_BY_KEY_HPP
@@ -0,0 +1,83 @@
+/**
+ * Sorting Networks - C++ Implementation
+ * Author: Mario Raúl Carbonell Martínez
+ * Date: October 2026
+ *
+ * Fixed-size, branch-free sorting of small blocks, used by
+ * block_merge_segment_sort to start random input from sorted blocks instead
+ * of runs of ~2 elements.
+ *
+ * - sort_network<N> is a bitonic network for a compile-time power of two N
+ *   (N/2 * log2 N * (log2 N + 1) / 2 compare-exchanges: 24 for 8, 80 for 16,
+ *   240 for 32). It has more comparators than the best known networks (19,
+ *   60, 185) but every layer compares a[j + i] with a[j + i + k] for a
+ *   contiguous range of i, so the compiler unrolls it and turns the layers
+ *   into vector min/max for integer keys.
+ * - Compare-exchanges are selects, not branches: the cost does not depend
+ *   on the data.
+ * - A network is not stable. network_sortable<T, Compare> only accepts
+ *   integral keys ordered by std::less / std::greater, where equal keys are
+ *   indistinguishable and stability cannot be observed.
+ */
+
+#ifndef SORTING_NETWORK_HPP
+#define SORTING_NETWORK_HPP
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+namespace segment_sort {
+
+    // True when sort_network may replace a stable sort of T under Compare
+    template<typename T, typename Compare>
+    struct network_sortable : std::integral_constant<bool,
+        std::is_integral<T>::value &&
+        (std::is_same<Compare, std::less<T>>::value || std::is_same<Compare, std::less<>>::value ||
+         std::is_same<Compare, std::greater<T>>::value || std::is_same<Compare, std::greater<>>::value)> {};
+
+    // Number of compare-exchanges of sort_network<N>
+    constexpr size_t sorting_network_size(size_t n) {
+        size_t log_n = 0;
+        while ((size_t(1) << log_n) < n) ++log_n;
+        return n / 2 * log_n * (log_n + 1) / 2;
+    }
+
+    // Helper: Order a, b with selects (min/max for arithmetic keys)
+    template<typename T, typename Compare>
+    inline void compare_exchange(T& a, T& b, Compare comp) {
+        const T x = a;
+        const T y = b;
+        const bool swap = comp(y, x);
+        a = swap ? y : x;
+        b = swap ? x : y;
+    }
+
+    /**
+     * Sorts arr[0..N) with a bitonic network. Each stage merges sorted
+     * blocks of p into blocks of 2p: the first layer compares element i
+     * with its mirror 2p - 1 - i (which turns two ascending blocks into a
+     * bitonic sequence without direction flags), the next layers are
+     * half-cleaners of stride p/2, p/4, ..., 1.
+     */
+    template<size_t N, typename T, typename Compare>
+    inline void sort_network(T* arr, Compare comp) {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "sort_network: N must be a power of two >= 2");
+        for (size_t p = 1; p < N; p <<= 1) {
+            for (size_t j = 0; j < N; j += 2 * p) {
+                for (size_t i = 0; i < p; ++i) {
+                    compare_exchange(arr[j + i], arr[j + 2 * p - 1 - i], comp);
+                }
+            }
+            for (size_t k = p / 2; k > 0; k >>= 1) {
+                for (size_t j = 0; j < N; j += 2 * k) {
+                    for (size_t i = 0; i < k; ++i) {
+                        compare_exchange(arr[j + i], arr[j + i + k], comp);
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif // SORTING_NETWORK_HPP
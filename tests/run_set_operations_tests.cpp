@@ -0,0 +1,258 @@
+/**
+ * Set Operations Test Suite (C++)
+ *
+ * Checks segment_sort::set_union / set_intersection / set_difference /
+ * merge_unique (set_operations.h) against std::set_union /
+ * std::set_intersection / std::set_difference and std::set_union +
+ * std::unique, element by element, on multisets, empty inputs and inputs
+ * of very different sizes:
+ * - int32_t and int64_t under std::less and std::greater, which the AVX2
+ *   build sends through the SIMD intersection (clean blocks, blocks with
+ *   duplicates, and the hand-off to the scalar walk)
+ * - tagged records compared by key only: the std algorithms take equal
+ *   elements from the first input, and so must these, copy for copy
+ *
+ * With -mavx2 the binary exits with 77 (skipped) on CPUs without AVX2.
+ *
+ * Build: g++ -O2 -std=c++17 run_set_operations_tests.cpp -o run_set_operations_tests
+ *        (add -mavx2 to test the SIMD intersection)
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <cstdint>
+
+#include "../implementations/cpp/set_operations.h"
+
+#ifdef SET_OPS_TESTS_REQUIRE_SIMD
+static_assert(SEGMENT_SORT_SIMD_INTERSECTION, "this build must compile the SIMD intersection in");
+#endif
+
+using namespace std;
+
+// Key plus (input, position) tag; only the key takes part in comparisons
+struct Tagged {
+    int32_t key;
+    int32_t tag;
+};
+
+bool operator==(const Tagged& a, const Tagged& b) {
+    return a.key == b.key && a.tag == b.tag;
+}
+
+bool tagged_less(const Tagged& a, const Tagged& b) {
+    return a.key < b.key;
+}
+
+// --- Test cases (keys of both inputs, unsorted) ---
+
+struct SetTest {
+    string name;
+    vector<int64_t> a;
+    vector<int64_t> b;
+};
+
+vector<int64_t> random_keys(size_t n, int64_t lo, int64_t hi, unsigned seed) {
+    mt19937_64 gen(seed);
+    uniform_int_distribution<int64_t> dis(lo, hi);
+    vector<int64_t> keys(n);
+    for (auto& k : keys) k = dis(gen);
+    return keys;
+}
+
+// Each of range values is in a and in b with probability 1/2; with
+// double_every > 0, about one in double_every of them is there twice
+void random_sets(vector<int64_t>& a, vector<int64_t>& b, int64_t range, unsigned double_every, unsigned seed) {
+    mt19937 gen(seed);
+    for (int64_t v = 0; v < range; ++v) {
+        const uint32_t bits = gen();
+        const int copies = double_every > 0 && (bits >> 8) % double_every == 0 ? 2 : 1;
+        for (int c = 0; c < copies; ++c) {
+            if (bits & 1) a.push_back(v);
+            if (bits & 2) b.push_back(v);
+        }
+    }
+}
+
+// Alternating stretches of block keys, no overlap: long one-sided runs
+void alternating_blocks(vector<int64_t>& a, vector<int64_t>& b, int64_t n, int64_t block) {
+    for (int64_t v = 0; v < n; ++v) ((v / block) % 2 == 0 ? a : b).push_back(v);
+}
+
+vector<SetTest> build_tests() {
+    vector<SetTest> tests = {
+        {"Both empty", {}, {}},
+        {"First empty", {}, {3, 1, 2, 2}},
+        {"Second empty", {5, 5, 4, -1}, {}},
+        {"Single equal element", {7}, {7}},
+        {"Single different elements", {7}, {8}},
+        {"All equal keys (10 vs 4 copies)", vector<int64_t>(10, 4), vector<int64_t>(4, 4)},
+        {"All equal keys (3 vs 20 copies)", vector<int64_t>(3, -9), vector<int64_t>(20, -9)},
+        {"Duplicates at both ends", {1, 1, 1, 2, 3, 9, 9}, {1, 1, 3, 3, 9, 9, 9, 9}},
+    };
+
+    vector<int64_t> seq(5000);
+    for (size_t i = 0; i < seq.size(); ++i) seq[i] = static_cast<int64_t>(i) - 2500;
+    tests.push_back({"Identical (5000)", seq, seq});
+    tests.push_back({"First entirely below second", vector<int64_t>(seq.begin(), seq.begin() + 2500),
+                     vector<int64_t>(seq.begin() + 2500, seq.end())});
+    tests.push_back({"First entirely above second", vector<int64_t>(seq.begin() + 2500, seq.end()),
+                     vector<int64_t>(seq.begin(), seq.begin() + 2500)});
+
+    SetTest blocks{"Alternating blocks of 1000", {}, {}};
+    alternating_blocks(blocks.a, blocks.b, 20000, 1000);
+    tests.push_back(blocks);
+
+    // Sizes around the SIMD block widths (8 x int32, 4 x int64)
+    for (int64_t range : {7, 9, 17, 33, 70}) {
+        SetTest small{"Sets 50% of " + to_string(range) + " values", {}, {}};
+        random_sets(small.a, small.b, range, 0, static_cast<unsigned>(range));
+        tests.push_back(small);
+    }
+
+    SetTest sets{"Sets 50% of 20000 values", {}, {}};
+    random_sets(sets.a, sets.b, 20000, 0, 1);
+    tests.push_back(sets);
+    SetTest some_doubled{"Sets 50%, 1 in 40 values doubled", {}, {}};
+    random_sets(some_doubled.a, some_doubled.b, 20000, 40, 2);
+    tests.push_back(some_doubled);
+    SetTest many_doubled{"Sets 50%, 1 in 3 values doubled", {}, {}};
+    random_sets(many_doubled.a, many_doubled.b, 20000, 3, 3);
+    tests.push_back(many_doubled);
+
+    tests.push_back({"Multisets, 10K keys from 50 values", random_keys(10000, 0, 49, 4), random_keys(10000, 0, 49, 5)});
+    tests.push_back({"Multisets, 10K keys from 5000 values", random_keys(10000, 0, 4999, 6),
+                     random_keys(10000, 0, 4999, 7)});
+    tests.push_back({"Negative and positive keys", random_keys(3000, -1000, 1000, 8), random_keys(4000, -1000, 1000, 9)});
+    tests.push_back({"Sparse overlap", random_keys(10000, 0, 1000000, 10), random_keys(10000, 0, 1000000, 11)});
+
+    // Size ratios on both sides of SET_OPS_SIMD_MAX_RATIO (32) and far beyond
+    tests.push_back({"Uneven 1:16", random_keys(625, 0, 19999, 12), random_keys(10000, 0, 19999, 13)});
+    tests.push_back({"Uneven 1:40", random_keys(250, 0, 19999, 14), random_keys(10000, 0, 19999, 15)});
+    tests.push_back({"Uneven 1:1000", random_keys(20, 0, 19999, 16), random_keys(20000, 0, 19999, 17)});
+    tests.push_back({"Uneven 1000:1", random_keys(20000, 0, 19999, 18), random_keys(20, 0, 19999, 19)});
+    tests.push_back({"Uneven 1:20000", {10000}, random_keys(20000, 0, 19999, 20)});
+    return tests;
+}
+
+// --- Checks ---
+
+int64_t key_of(const Tagged& x) {
+    return x.key;
+}
+
+template<typename T>
+int64_t key_of(T x) {
+    return static_cast<int64_t>(x);
+}
+
+template<typename T>
+T make_element(int64_t key, int32_t tag) {
+    if constexpr (std::is_same<T, Tagged>::value) {
+        return Tagged{static_cast<int32_t>(key), tag};
+    } else {
+        (void)tag;
+        return static_cast<T>(key);
+    }
+}
+
+// Sorted input; tags record the input (0 or 1) and the sorted position
+template<typename T, typename Compare>
+vector<T> build_input(const vector<int64_t>& keys, int32_t input, Compare comp) {
+    vector<T> out;
+    for (int64_t key : keys) out.push_back(make_element<T>(key, 0));
+    stable_sort(out.begin(), out.end(), comp);
+    for (size_t i = 0; i < out.size(); ++i) out[i] = make_element<T>(key_of(out[i]), input * 1000000 + static_cast<int32_t>(i));
+    return out;
+}
+
+// Returns an empty string if result equals expected, otherwise a description
+template<typename T>
+string compare_results(const vector<T>& result, const vector<T>& expected) {
+    if (result.size() != expected.size()) {
+        return "size " + to_string(result.size()) + ", expected " + to_string(expected.size());
+    }
+    for (size_t i = 0; i < result.size(); ++i) {
+        if (!(result[i] == expected[i])) {
+            return "mismatch at position " + to_string(i) + ": key " + to_string(key_of(result[i])) +
+                   ", expected key " + to_string(key_of(expected[i]));
+        }
+    }
+    return "";
+}
+
+template<typename T, typename Compare>
+string check_operations(const vector<T>& a, const vector<T>& b, Compare comp) {
+    vector<T> expected;
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), back_inserter(expected), comp);
+    string details = compare_results(segment_sort::set_union(a, b, comp), expected);
+    if (!details.empty()) return "set_union: " + details;
+
+    expected.erase(unique(expected.begin(), expected.end(),
+                          [&](const T& x, const T& y) { return !comp(x, y) && !comp(y, x); }),
+                   expected.end());
+    details = compare_results(segment_sort::merge_unique(a, b, comp), expected);
+    if (!details.empty()) return "merge_unique: " + details;
+
+    expected.clear();
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), back_inserter(expected), comp);
+    details = compare_results(segment_sort::set_intersection(a, b, comp), expected);
+    if (!details.empty()) return "set_intersection: " + details;
+
+    expected.clear();
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), back_inserter(expected), comp);
+    details = compare_results(segment_sort::set_difference(a, b, comp), expected);
+    if (!details.empty()) return "set_difference: " + details;
+    return "";
+}
+
+template<typename T, typename Compare>
+int run_set_tests(Compare comp, const string& suite_name, const vector<SetTest>& tests) {
+    int passed = 0;
+    int failed = 0;
+
+    for (size_t i = 0; i < tests.size(); ++i) {
+        const vector<T> a = build_input<T>(tests[i].a, 0, comp);
+        const vector<T> b = build_input<T>(tests[i].b, 1, comp);
+        string details = check_operations(a, b, comp);
+        if (details.empty()) {
+            passed++;
+        } else {
+            cout << "  Test " << (i + 1) << ": " << tests[i].name << endl;
+            cout << "    Status: FAILED - " << details << endl;
+            failed++;
+        }
+    }
+
+    cout << "  " << suite_name << ": " << passed << " passed, " << failed << " failed." << endl;
+    return failed;
+}
+
+int main() {
+#if SEGMENT_SORT_SIMD_INTERSECTION
+    if (!__builtin_cpu_supports("avx2")) {
+        cout << "CPU without AVX2: set operations tests skipped." << endl;
+        return 77;
+    }
+#endif
+
+    cout << "=== Set Operations Test Suite (C++) ===" << endl;
+    cout << "SIMD intersection: " << (SEGMENT_SORT_SIMD_INTERSECTION ? "AVX2" : "off (scalar build)") << endl << endl;
+
+    vector<SetTest> tests = build_tests();
+    int total_failed = 0;
+
+    total_failed += run_set_tests<int32_t>(std::less<int32_t>(), "int32, std::less", tests);
+    total_failed += run_set_tests<int32_t>(std::greater<int32_t>(), "int32, std::greater", tests);
+    total_failed += run_set_tests<int64_t>(std::less<int64_t>(), "int64, std::less", tests);
+    total_failed += run_set_tests<int64_t>(std::greater<int64_t>(), "int64, std::greater", tests);
+    total_failed += run_set_tests<Tagged>(tagged_less, "tagged records by key", tests);
+
+    cout << endl << (total_failed == 0 ? "All set operations tests passed." : "Set operations tests FAILED.") << endl;
+    return total_failed == 0 ? 0 : 1;
+}
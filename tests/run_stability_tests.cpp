@@ -0,0 +1,281 @@
+/**
+ * Stability Test Suite for Segment Sort Algorithms (C++)
+ *
+ * A stable sort preserves the relative order of elements with equal keys.
+ * Each element is a tagged record (key, originalIndex) compared by key only.
+ * After sorting, records sharing a key must appear with ascending original
+ * indices.
+ *
+ * Covers every C++ entry point: block_merge_segment_sort (all merge
+ * policies, min run on/off, tiny buffer to force the in-place block merge
+ * and its SymMerge fallback, auto-sized buffer), sort_by_key, argsort and
+ * SegmentSort::Iterator, plus merge_k / parallel_merge_k over separately
+ * sorted chunks of the input. Records packed into uint64_t keys go through the
+ * sorting network pre-pass, which only runs on integral keys, and through
+ * the algorithms segment_sort::sort may pick for them (counting, radix,
+ * pdqsort).
+ *
+ * Build: g++ -O2 -std=c++17 run_stability_tests.cpp -o run_stability_tests
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <functional>
+#include <cstdint>
+
+#include "../implementations/cpp/block_merge_segment_sort.h"
+#include "../implementations/cpp/sort_by_key.h"
+#include "../implementations/cpp/argsort.h"
+#include "../implementations/cpp/SegmentSortIterator.h"
+#include "../implementations/cpp/auto_sort.h"
+#include "../implementations/cpp/merge_k.h"
+
+using namespace std;
+
+struct Record {
+    int key;
+    int index;
+};
+
+bool by_key(const Record& a, const Record& b) {
+    return a.key < b.key;
+}
+
+vector<Record> build_records(const vector<int>& keys) {
+    vector<Record> records(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        records[i] = {keys[i], static_cast<int>(i)};
+    }
+    return records;
+}
+
+// Returns an empty string if sorted and stable, otherwise a description.
+string check_stability(const vector<Record>& sorted, size_t expected_size) {
+    if (sorted.size() != expected_size) {
+        return "size mismatch: " + to_string(sorted.size()) + " vs " + to_string(expected_size);
+    }
+    for (size_t i = 1; i < sorted.size(); ++i) {
+        const Record& prev = sorted[i - 1];
+        const Record& curr = sorted[i];
+        if (prev.key > curr.key) {
+            return "not sorted: key " + to_string(prev.key) + " before key " + to_string(curr.key) +
+                   " at position " + to_string(i);
+        }
+        if (prev.key == curr.key && prev.index >= curr.index) {
+            return "unstable: key=" + to_string(prev.key) + ", original index " + to_string(prev.index) +
+                   " appeared before " + to_string(curr.index) + " (positions " + to_string(i - 1) +
+                   "," + to_string(i) + ")";
+        }
+    }
+    return "";
+}
+
+// --- Test cases ---
+
+struct StabilityTest {
+    string name;
+    vector<int> keys;
+};
+
+vector<int> random_keys(size_t n, int unique, unsigned seed) {
+    mt19937 gen(seed);
+    uniform_int_distribution<> dis(0, unique - 1);
+    vector<int> keys(n);
+    for (auto& k : keys) k = dis(gen);
+    return keys;
+}
+
+// Descending blocks of equal keys: 9,9,9,8,8,8,... (equal runs inside a descent)
+vector<int> descending_blocks(size_t n, size_t block) {
+    vector<int> keys(n);
+    for (size_t i = 0; i < n; ++i) keys[i] = static_cast<int>((n - i - 1) / block);
+    return keys;
+}
+
+vector<StabilityTest> build_tests() {
+    vector<StabilityTest> tests = {
+        {"All equal keys (5 elements)", {3, 3, 3, 3, 3}},
+        {"All equal keys (10 elements)", {7, 7, 7, 7, 7, 7, 7, 7, 7, 7}},
+        {"Two groups of equal keys", {2, 1, 2, 1, 2, 1}},
+        {"Three groups interleaved", {3, 1, 2, 3, 1, 2, 3, 1, 2}},
+        {"Duplicates at boundaries", {1, 1, 2, 3, 3, 3, 4, 4, 5, 5}},
+        {"Reverse sorted with duplicates", {5, 5, 4, 4, 3, 3, 2, 2, 1, 1}},
+        {"Already sorted with duplicates", {1, 1, 2, 2, 3, 3, 4, 4, 5, 5}},
+        {"Single unique value among many", {5, 5, 5, 3, 5, 5, 5}},
+        {"Pipe organ with duplicates", {1, 2, 3, 4, 4, 3, 2, 1}},
+        {"Many duplicates few uniques", {2, 1, 1, 2, 1, 2, 2, 1, 1, 2, 1, 2}},
+        {"Large array with duplicate blocks", {3, 3, 3, 3, 3, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 4, 4, 4, 4, 4}},
+        {"Alternating two values (20 elements)", {1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2}},
+        {"Sawtooth with duplicates", {1, 2, 3, 1, 2, 3, 1, 2, 3, 1, 2, 3}},
+        {"Random-like with many ties", {4, 2, 3, 1, 4, 2, 3, 1, 4, 2, 3, 1, 4, 2, 3, 1}},
+        {"Descent with a tie in the middle", {5, 3, 3, 1}},
+        {"Empty array", {}},
+        {"Single element", {42}},
+    };
+
+    vector<int> fifty(50);
+    for (size_t i = 0; i < fifty.size(); ++i) fifty[i] = static_cast<int>((i * 7 + 3) % 5);
+    tests.push_back({"50 elements with 5 unique keys", fifty});
+
+    tests.push_back({"10K random keys, 10 unique", random_keys(10000, 10, 1)});
+    tests.push_back({"10K random keys, 1000 unique", random_keys(10000, 1000, 2)});
+    tests.push_back({"10K descending blocks of 3", descending_blocks(10000, 3)});
+    tests.push_back({"200K random keys, 100 unique", random_keys(200000, 100, 3)});
+    tests.push_back({"200K random keys, 100000 unique", random_keys(200000, 100000, 4)});
+    return tests;
+}
+
+// --- Sorters (all take tagged records and return them sorted) ---
+
+using Sorter = function<vector<Record>(const vector<Record>&)>;
+
+template<size_t MinRun, typename Policy>
+Sorter block_merge(size_t buffer_size) {
+    return [buffer_size](const vector<Record>& input) {
+        vector<Record> arr = input;
+        segment_sort::block_merge_segment_sort<MinRun, Policy>(arr.data(), arr.size(), buffer_size, by_key);
+        return arr;
+    };
+}
+
+// (key, index) packed into one uint64_t, sorted with std::less: the sorting
+// network path must leave equal keys in index order like the merges do
+template<bool AutoSort, size_t NetworkSize>
+vector<Record> packed_sorter(const vector<Record>& input) {
+    vector<uint64_t> packed(input.size());
+    for (size_t i = 0; i < input.size(); ++i) {
+        const uint32_t key = static_cast<uint32_t>(input[i].key) ^ 0x80000000u; // signed order
+        packed[i] = (static_cast<uint64_t>(key) << 32) | static_cast<uint32_t>(input[i].index);
+    }
+    if (AutoSort) {
+        segment_sort::sort(packed);
+    } else {
+        segment_sort::block_merge_segment_sort<BLOCK_MERGE_DEFAULT_MIN_RUN, segment_sort::BalancedMergePolicy, NetworkSize>(
+            packed.data(), packed.size(), BLOCK_MERGE_DEFAULT_BUFFER_SIZE, std::less<uint64_t>());
+    }
+    vector<Record> out(input.size());
+    for (size_t i = 0; i < input.size(); ++i) {
+        out[i] = {static_cast<int>(static_cast<uint32_t>(packed[i] >> 32) ^ 0x80000000u),
+                  static_cast<int>(static_cast<uint32_t>(packed[i]))};
+    }
+    return out;
+}
+
+// Records are not integral keys: segment_sort::sort must use the block merge
+vector<Record> auto_sorter(const vector<Record>& input) {
+    vector<Record> arr = input;
+    segment_sort::sort(arr, by_key);
+    return arr;
+}
+
+// Sorts 7 chunks separately, then merges them: equal keys must come out in
+// chunk order (the parallel merge splits the 200K cases into slices)
+template<bool Parallel>
+vector<Record> merge_k_sorter(const vector<Record>& input) {
+    const size_t chunks = 7;
+    vector<Record> arr = input;
+    vector<segment_sort::SortedSpan<Record>> spans;
+    for (size_t c = 0; c < chunks; ++c) {
+        const size_t begin = arr.size() * c / chunks;
+        const size_t end = arr.size() * (c + 1) / chunks;
+        segment_sort::block_merge_segment_sort(arr.data() + begin, end - begin, BLOCK_MERGE_DEFAULT_BUFFER_SIZE, by_key);
+        spans.emplace_back(arr.data() + begin, end - begin);
+    }
+    vector<Record> out(arr.size());
+    if (Parallel) {
+        segment_sort::parallel_merge_k(spans, out.data(), 4, by_key);
+    } else {
+        segment_sort::merge_k(spans, out.data(), by_key);
+    }
+    return out;
+}
+
+vector<Record> sort_by_key_sorter(const vector<Record>& input) {
+    vector<int> keys(input.size());
+    vector<int> indices(input.size());
+    for (size_t i = 0; i < input.size(); ++i) {
+        keys[i] = input[i].key;
+        indices[i] = input[i].index;
+    }
+    segment_sort::sort_by_key(keys, indices);
+    vector<Record> out(input.size());
+    for (size_t i = 0; i < input.size(); ++i) out[i] = {keys[i], indices[i]};
+    return out;
+}
+
+vector<Record> argsort_sorter(const vector<Record>& input) {
+    vector<uint32_t> perm(input.size());
+    segment_sort::argsort(input.data(), input.size(), perm.data(), by_key);
+    vector<Record> out(input.size());
+    for (size_t i = 0; i < input.size(); ++i) out[i] = input[perm[i]];
+    return out;
+}
+
+vector<Record> iterator_sorter(const vector<Record>& input) {
+    SegmentSort::Iterator<Record, bool (*)(const Record&, const Record&)> iter(input, by_key);
+    vector<Record> out;
+    out.reserve(input.size());
+    while (iter.hasNext()) out.push_back(iter.next());
+    return out;
+}
+
+int run_stability_tests(const Sorter& sort_fn, const string& sort_name, const vector<StabilityTest>& tests) {
+    int passed = 0;
+    int failed = 0;
+
+    for (size_t i = 0; i < tests.size(); ++i) {
+        vector<Record> records = build_records(tests[i].keys);
+        string details = check_stability(sort_fn(records), records.size());
+        if (details.empty()) {
+            passed++;
+        } else {
+            cout << "  Test " << (i + 1) << ": " << tests[i].name << endl;
+            cout << "    Status: FAILED - " << details << endl;
+            failed++;
+        }
+    }
+
+    cout << "  " << sort_name << ": " << passed << " passed, " << failed << " failed." << endl;
+    return failed;
+}
+
+int main() {
+    using namespace segment_sort;
+
+    cout << "=== Stability Test Suite (C++) ===" << endl << endl;
+
+    vector<StabilityTest> tests = build_tests();
+    int total_failed = 0;
+
+    total_failed += run_stability_tests(block_merge<BLOCK_MERGE_DEFAULT_MIN_RUN, BalancedMergePolicy>(BLOCK_MERGE_DEFAULT_BUFFER_SIZE),
+                                        "Block Merge (default)", tests);
+    total_failed += run_stability_tests(block_merge<0, BalancedMergePolicy>(BLOCK_MERGE_DEFAULT_BUFFER_SIZE),
+                                        "Block Merge (MinRun=0)", tests);
+    total_failed += run_stability_tests(block_merge<BLOCK_MERGE_DEFAULT_MIN_RUN, BalancedMergePolicy>(16),
+                                        "Block Merge (buffer=16, in-place)", tests);
+    total_failed += run_stability_tests(block_merge<0, BalancedMergePolicy>(0),
+                                        "Block Merge (MinRun=0, no buffer)", tests);
+    total_failed += run_stability_tests(block_merge<BLOCK_MERGE_DEFAULT_MIN_RUN, BalancedMergePolicy>(BLOCK_MERGE_AUTO_BUFFER_SIZE),
+                                        "Block Merge (auto buffer)", tests);
+    total_failed += run_stability_tests(block_merge<BLOCK_MERGE_DEFAULT_MIN_RUN, BalancedMergePolicy>(BLOCK_MERGE_AUTO_GROW_BUFFER_SIZE),
+                                        "Block Merge (auto buffer, grow)", tests);
+    total_failed += run_stability_tests(block_merge<BLOCK_MERGE_DEFAULT_MIN_RUN, TimSortMergePolicy>(BLOCK_MERGE_DEFAULT_BUFFER_SIZE),
+                                        "Block Merge (TimSort policy)", tests);
+    total_failed += run_stability_tests(block_merge<BLOCK_MERGE_DEFAULT_MIN_RUN, PowerSortMergePolicy>(BLOCK_MERGE_DEFAULT_BUFFER_SIZE),
+                                        "Block Merge (PowerSort policy)", tests);
+    total_failed += run_stability_tests(packed_sorter<false, 8>, "Block Merge (packed keys, network=8)", tests);
+    total_failed += run_stability_tests(packed_sorter<false, BLOCK_MERGE_DEFAULT_NETWORK_SIZE>,
+                                        "Block Merge (packed keys, network=32)", tests);
+    total_failed += run_stability_tests(auto_sorter, "segment_sort::sort", tests);
+    total_failed += run_stability_tests(packed_sorter<true, 0>, "segment_sort::sort (packed keys)", tests);
+    total_failed += run_stability_tests(merge_k_sorter<false>, "merge_k (7 chunks)", tests);
+    total_failed += run_stability_tests(merge_k_sorter<true>, "parallel_merge_k (7 chunks, 4 threads)", tests);
+    total_failed += run_stability_tests(sort_by_key_sorter, "sort_by_key", tests);
+    total_failed += run_stability_tests(argsort_sorter, "argsort", tests);
+    total_failed += run_stability_tests(iterator_sorter, "SegmentSort::Iterator", tests);
+
+    cout << endl << (total_failed == 0 ? "All stability tests passed." : "Stability tests FAILED.") << endl;
+    return total_failed == 0 ? 0 : 1;
+}